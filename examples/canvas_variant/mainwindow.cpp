@@ -116,9 +116,6 @@ MainWindow::MainWindow(QWidget *parent)
 
     variantManager = new QtVariantPropertyManager(this);
 
-    connect(variantManager, SIGNAL(valueChanged(QtProperty *, const QVariant &)),
-                this, SLOT(valueChanged(QtProperty *, const QVariant &)));
-
     QtVariantEditorFactory *variantFactory = new QtVariantEditorFactory(this);
 
     canvas = new QtCanvas(800, 600);
@@ -133,6 +130,7 @@ MainWindow::MainWindow(QWidget *parent)
     dock->setWidget(propertyEditor);
 
     currentItem = 0;
+    currentSchema = 0;
 
     connect(canvasView, SIGNAL(itemClicked(QtCanvasItem *)),
             this, SLOT(itemClicked(QtCanvasItem *)));
@@ -250,131 +248,134 @@ void MainWindow::itemMoved(QtCanvasItem *item)
     if (item != currentItem)
         return;
 
-    variantManager->setValue(idToProperty[QLatin1String("xpos")], item->x());
-    variantManager->setValue(idToProperty[QLatin1String("ypos")], item->y());
-    variantManager->setValue(idToProperty[QLatin1String("zpos")], item->z());
+    currentSchema->setValue(QLatin1String("xpos"), item->x());
+    currentSchema->setValue(QLatin1String("ypos"), item->y());
+    currentSchema->setValue(QLatin1String("zpos"), item->z());
 }
 
 void MainWindow::updateExpandState()
 {
+    if (!currentSchema)
+        return;
+
     QList<QtBrowserItem *> list = propertyEditor->topLevelItems();
     QListIterator<QtBrowserItem *> it(list);
     while (it.hasNext()) {
         QtBrowserItem *item = it.next();
         QtProperty *prop = item->property();
-        idToExpanded[propertyToId[prop]] = propertyEditor->isExpanded(item);
+        idToExpanded[currentSchema->id(prop)] = propertyEditor->isExpanded(item);
     }
 }
 
 void MainWindow::itemClicked(QtCanvasItem *item)
 {
-    updateExpandState();
+    currentItem = item;
+    deleteAction->setEnabled(currentItem != 0);
 
-    QMap<QtProperty *, QString>::ConstIterator itProp = propertyToId.constBegin();
-    while (itProp != propertyToId.constEnd()) {
-        delete itProp.key();
-        itProp++;
+    QtVariantPropertySchema *schema = 0;
+    if (currentItem) {
+        schema = schemaForItem(currentItem);
+        schema->setValues(itemValues(currentItem));
     }
-    propertyToId.clear();
-    idToProperty.clear();
 
-    currentItem = item;
-    if (!currentItem) {
-        deleteAction->setEnabled(false);
+    if (schema == currentSchema)
+        return;
+
+    updateExpandState();
+    propertyEditor->clear();
+
+    currentSchema = schema;
+    if (!currentSchema)
         return;
+
+    QListIterator<QtProperty *> it(currentSchema->properties());
+    while (it.hasNext()) {
+        QtProperty *property = it.next();
+        QtBrowserItem *browserItem = propertyEditor->addProperty(property);
+        const QString id = currentSchema->id(property);
+        if (idToExpanded.contains(id))
+            propertyEditor->setExpanded(browserItem, idToExpanded[id]);
     }
+}
 
-    deleteAction->setEnabled(true);
+QtVariantPropertySchema *MainWindow::schemaForItem(QtCanvasItem *item)
+{
+    const int rtti = item->rtti();
+    QtVariantPropertySchema *schema = rttiToSchema.value(rtti);
+    if (schema)
+        return schema;
+
+    schema = new QtVariantPropertySchema(variantManager, this);
+    connect(schema, SIGNAL(valueChanged(const QString &, const QVariant &)),
+                this, SLOT(valueChanged(const QString &, const QVariant &)));
+    rttiToSchema[rtti] = schema;
 
     QtVariantProperty *property;
 
-    property = variantManager->addProperty(QVariant::Double, tr("Position X"));
+    property = schema->addProperty(QLatin1String("xpos"), QVariant::Double, tr("Position X"));
     property->setAttribute(QLatin1String("minimum"), 0);
     property->setAttribute(QLatin1String("maximum"), canvas->width());
-    property->setValue(item->x());
-    addProperty(property, QLatin1String("xpos"));
 
-    property = variantManager->addProperty(QVariant::Double, tr("Position Y"));
+    property = schema->addProperty(QLatin1String("ypos"), QVariant::Double, tr("Position Y"));
     property->setAttribute(QLatin1String("minimum"), 0);
     property->setAttribute(QLatin1String("maximum"), canvas->height());
-    property->setValue(item->y());
-    addProperty(property, QLatin1String("ypos"));
 
-    property = variantManager->addProperty(QVariant::Double, tr("Position Z"));
+    property = schema->addProperty(QLatin1String("zpos"), QVariant::Double, tr("Position Z"));
     property->setAttribute(QLatin1String("minimum"), 0);
     property->setAttribute(QLatin1String("maximum"), 256);
-    property->setValue(item->z());
-    addProperty(property, QLatin1String("zpos"));
-
-    if (item->rtti() == QtCanvasItem::Rtti_Rectangle) {
-        QtCanvasRectangle *i = (QtCanvasRectangle *)item;
 
-        property = variantManager->addProperty(QVariant::Color, tr("Brush Color"));
-        property->setValue(i->brush().color());
-        addProperty(property, QLatin1String("brush"));
+    if (rtti == QtCanvasItem::Rtti_Rectangle) {
+        schema->addProperty(QLatin1String("brush"), QVariant::Color, tr("Brush Color"));
+        schema->addProperty(QLatin1String("pen"), QVariant::Color, tr("Pen Color"));
+        schema->addProperty(QLatin1String("size"), QVariant::Size, tr("Size"));
+    } else if (rtti == QtCanvasItem::Rtti_Line) {
+        schema->addProperty(QLatin1String("pen"), QVariant::Color, tr("Pen Color"));
+        schema->addProperty(QLatin1String("endpoint"), QVariant::Point, tr("Vector"));
+    } else if (rtti == QtCanvasItem::Rtti_Ellipse) {
+        schema->addProperty(QLatin1String("brush"), QVariant::Color, tr("Brush Color"));
+        schema->addProperty(QLatin1String("size"), QVariant::Size, tr("Size"));
+    } else if (rtti == QtCanvasItem::Rtti_Text) {
+        schema->addProperty(QLatin1String("color"), QVariant::Color, tr("Color"));
+        schema->addProperty(QLatin1String("text"), QVariant::String, tr("Text"));
+        schema->addProperty(QLatin1String("font"), QVariant::Font, tr("Font"));
+    }
+    return schema;
+}
 
-        property = variantManager->addProperty(QVariant::Color, tr("Pen Color"));
-        property->setValue(i->pen().color());
-        addProperty(property, QLatin1String("pen"));
+QMap<QString, QVariant> MainWindow::itemValues(QtCanvasItem *item) const
+{
+    QMap<QString, QVariant> values;
+    values[QLatin1String("xpos")] = item->x();
+    values[QLatin1String("ypos")] = item->y();
+    values[QLatin1String("zpos")] = item->z();
 
-        property = variantManager->addProperty(QVariant::Size, tr("Size"));
-        property->setValue(i->size());
-        addProperty(property, QLatin1String("size"));
+    if (item->rtti() == QtCanvasItem::Rtti_Rectangle) {
+        QtCanvasRectangle *i = (QtCanvasRectangle *)item;
+        values[QLatin1String("brush")] = i->brush().color();
+        values[QLatin1String("pen")] = i->pen().color();
+        values[QLatin1String("size")] = i->size();
     } else if (item->rtti() == QtCanvasItem::Rtti_Line) {
         QtCanvasLine *i = (QtCanvasLine *)item;
-
-        property = variantManager->addProperty(QVariant::Color, tr("Pen Color"));
-        property->setValue(i->pen().color());
-        addProperty(property, QLatin1String("pen"));
-
-        property = variantManager->addProperty(QVariant::Point, tr("Vector"));
-        property->setValue(i->endPoint());
-        addProperty(property, QLatin1String("endpoint"));
+        values[QLatin1String("pen")] = i->pen().color();
+        values[QLatin1String("endpoint")] = i->endPoint();
     } else if (item->rtti() == QtCanvasItem::Rtti_Ellipse) {
         QtCanvasEllipse *i = (QtCanvasEllipse *)item;
-
-        property = variantManager->addProperty(QVariant::Color, tr("Brush Color"));
-        property->setValue(i->brush().color());
-        addProperty(property, QLatin1String("brush"));
-
-        property = variantManager->addProperty(QVariant::Size, tr("Size"));
-        property->setValue(QSize(i->width(), i->height()));
-        addProperty(property, QLatin1String("size"));
+        values[QLatin1String("brush")] = i->brush().color();
+        values[QLatin1String("size")] = QSize(i->width(), i->height());
     } else if (item->rtti() == QtCanvasItem::Rtti_Text) {
         QtCanvasText *i = (QtCanvasText *)item;
-
-        property = variantManager->addProperty(QVariant::Color, tr("Color"));
-        property->setValue(i->color());
-        addProperty(property, QLatin1String("color"));
-
-        property = variantManager->addProperty(QVariant::String, tr("Text"));
-        property->setValue(i->text());
-        addProperty(property, QLatin1String("text"));
-
-        property = variantManager->addProperty(QVariant::Font, tr("Font"));
-        property->setValue(i->font());
-        addProperty(property, QLatin1String("font"));
+        values[QLatin1String("color")] = i->color();
+        values[QLatin1String("text")] = i->text();
+        values[QLatin1String("font")] = i->font();
     }
+    return values;
 }
 
-void MainWindow::addProperty(QtVariantProperty *property, const QString &id)
-{
-    propertyToId[property] = id;
-    idToProperty[id] = property;
-    QtBrowserItem *item = propertyEditor->addProperty(property);
-    if (idToExpanded.contains(id))
-        propertyEditor->setExpanded(item, idToExpanded[id]);
-}
-
-void MainWindow::valueChanged(QtProperty *property, const QVariant &value)
+void MainWindow::valueChanged(const QString &id, const QVariant &value)
 {
-    if (!propertyToId.contains(property))
-        return;
-
     if (!currentItem)
         return;
 
-    QString id = propertyToId[property];
     if (id == QLatin1String("xpos")) {
         currentItem->setX(value.toDouble());
     } else if (id == QLatin1String("ypos")) {
@@ -45,6 +45,7 @@
 #include "qtcanvas.h"
 
 class QtVariantProperty;
+class QtVariantPropertySchema;
 class QtProperty;
 
 class QtBrowserIndex;
@@ -88,14 +89,15 @@ private slots:
 
     void itemClicked(QtCanvasItem *item);
     void itemMoved(QtCanvasItem *item);
-    void valueChanged(QtProperty *property, const QVariant &value);
+    void valueChanged(const QString &id, const QVariant &value);
 private:
 
     QtCanvasItem *addRectangle();
     QtCanvasItem *addEllipse();
     QtCanvasItem *addLine();
     QtCanvasItem *addText();
-    void addProperty(QtVariantProperty *property, const QString &id);
+    QtVariantPropertySchema *schemaForItem(QtCanvasItem *item);
+    QMap<QString, QVariant> itemValues(QtCanvasItem *item) const;
     void updateExpandState();
 
     QAction *deleteAction;
@@ -106,8 +108,8 @@ private:
     CanvasView *canvasView;
     QtCanvas *canvas;
     QtCanvasItem *currentItem;
-    QMap<QtProperty *, QString> propertyToId;
-    QMap<QString, QtVariantProperty *> idToProperty;
+    QtVariantPropertySchema *currentSchema;
+    QMap<int, QtVariantPropertySchema *> rttiToSchema;
     QMap<QString, bool> idToExpanded;
 };
 
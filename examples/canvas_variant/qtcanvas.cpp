@@ -46,31 +46,337 @@
 #include <QTimer>
 #include <QHash>
 #include <QSet>
+#include <QVector>
 #include <QtAlgorithms>
 #include <QEvent>
 #include <QPaintEvent>
 #include <QPainterPath>
+#include <QAtomicInt>
+#include <QtMath>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QThreadPool>
 
 #include <stdlib.h>
+#include <algorithm>
 using namespace Qt;
 
+// A hierarchy of grids over the chunk matrix, used for collision queries.
+// Level l has cells of 2^l by 2^l chunks, and each visible item is listed
+// in the lowest level where its chunks span at most 2 by 2 cells, so that
+// unlike in the chunk lists a large item is listed a few times only.
+// Items that changed chunks are reindexed lazily by update().
+class QtCanvasItemIndex
+{
+public:
+    void reset(int chwidth, int chheight, const QSet<QtCanvasItem *> &items);
+
+    void markStale(QtCanvasItem *item)
+    {
+        if (!item->indexStale) {
+            item->indexStale = 1;
+            m_stale.insert(item);
+        }
+    }
+    void removeItem(QtCanvasItem *item);
+    void update(const QtCanvas *canvas);
+
+    // Returns the items whose chunks intersect the chunk rectangle
+    // \a bounds, each once, in no particular order.
+    QtCanvasItemList items(const QRect &bounds) const;
+
+private:
+    void insert(QtCanvasItem *item, const QRect &bounds);
+    void remove(QtCanvasItem *item);
+
+    struct Level
+    {
+        int width;
+        int height;
+        QVector<QVector<QtCanvasItem *> > cells;
+    };
+    QVector<Level> m_levels;
+    QSet<QtCanvasItem *> m_stale;
+};
+
+void QtCanvasItemIndex::reset(int chwidth, int chheight, const QSet<QtCanvasItem *> &items)
+{
+    m_levels.clear();
+    for (int l = 0; ; ++l) {
+        Level level;
+        level.width = (chwidth + (1 << l) - 1) >> l;
+        level.height = (chheight + (1 << l) - 1) >> l;
+        level.cells.resize(level.width*level.height);
+        m_levels.append(level);
+        if (level.width <= 1 && level.height <= 1)
+            break;
+    }
+
+    m_stale = items;
+    for (QSet<QtCanvasItem *>::const_iterator it = items.constBegin(); it != items.constEnd(); ++it) {
+        (*it)->indexLevel = -1;
+        (*it)->indexStale = 1;
+    }
+}
+
+void QtCanvasItemIndex::removeItem(QtCanvasItem *item)
+{
+    remove(item);
+    if (item->indexStale) {
+        m_stale.remove(item);
+        item->indexStale = 0;
+    }
+}
+
+void QtCanvasItemIndex::update(const QtCanvas *canvas)
+{
+    if (m_stale.isEmpty())
+        return;
+    const int chunksize = canvas->chunkSize();
+    const QRect canvasRect = canvas->rect();
+    for (QSet<QtCanvasItem *>::const_iterator it = m_stale.constBegin(); it != m_stale.constEnd(); ++it) {
+        QtCanvasItem *item = *it;
+        item->indexStale = 0;
+        remove(item);
+        if (item->isVisible() && item->canvas() == canvas) {
+            const QRect br = item->boundingRect() & canvasRect;
+            if (br.isValid())
+                insert(item, QRect(QPoint(br.left()/chunksize, br.top()/chunksize),
+                                   QPoint(br.right()/chunksize, br.bottom()/chunksize)));
+        }
+    }
+    m_stale.clear();
+}
+
+void QtCanvasItemIndex::insert(QtCanvasItem *item, const QRect &bounds)
+{
+    // The top level is a single cell, so this stops.
+    int l = 0;
+    while ((bounds.right() >> l) - (bounds.left() >> l) > 1
+           || (bounds.bottom() >> l) - (bounds.top() >> l) > 1)
+        ++l;
+
+    Level &level = m_levels[l];
+    for (int y = bounds.top() >> l; y <= bounds.bottom() >> l; ++y) {
+        for (int x = bounds.left() >> l; x <= bounds.right() >> l; ++x)
+            level.cells[x + y*level.width].append(item);
+    }
+    item->indexBounds = bounds;
+    item->indexLevel = l;
+}
+
+void QtCanvasItemIndex::remove(QtCanvasItem *item)
+{
+    const int l = item->indexLevel;
+    if (l < 0)
+        return;
+    const QRect &bounds = item->indexBounds;
+    Level &level = m_levels[l];
+    for (int y = bounds.top() >> l; y <= bounds.bottom() >> l; ++y) {
+        for (int x = bounds.left() >> l; x <= bounds.right() >> l; ++x)
+            level.cells[x + y*level.width].removeOne(item);
+    }
+    item->indexLevel = -1;
+}
+
+QtCanvasItemList QtCanvasItemIndex::items(const QRect &bounds) const
+{
+    QtCanvasItemList result;
+    for (int l = 0; l < m_levels.size(); ++l) {
+        const Level &level = m_levels.at(l);
+        const int x1 = bounds.left() >> l;
+        const int y1 = bounds.top() >> l;
+        const int x2 = qMin(bounds.right() >> l, level.width - 1);
+        const int y2 = qMin(bounds.bottom() >> l, level.height - 1);
+        for (int y = y1; y <= y2; ++y) {
+            for (int x = x1; x <= x2; ++x) {
+                const QVector<QtCanvasItem *> &cell = level.cells.at(x + y*level.width);
+                for (int i = 0; i < cell.size(); ++i) {
+                    QtCanvasItem *item = cell.at(i);
+                    const QRect &b = item->indexBounds;
+                    // An item listed in several of these cells is only
+                    // taken from the first one.
+                    if (b.intersects(bounds)
+                        && x == qMax(b.left() >> l, x1) && y == qMax(b.top() >> l, y1))
+                        result.append(item);
+                }
+            }
+        }
+    }
+    return result;
+}
+
 class QtCanvasData {
 public:
     QtCanvasData()
+        : paintEpoch(0), parallelAdvance(false)
     {
     }
 
     QList<QtCanvasView *> viewList;
     QSet<QtCanvasItem *> itemDict;
     QSet<QtCanvasItem *> animDict;
+    // Indices of the chunks marked as changed since the last update(),
+    // so that update() does not have to scan the whole chunk matrix.
+    QVector<int> changedChunks;
+
+    QtCanvasItemIndex index;
+
+    // All items, back to front. Kept sorted as items are added, removed
+    // or change z, so drawing never has to sort.
+    QVector<QtCanvasItem *> zOrder;
+    // Stamped into QtCanvasItem::paintEpoch to drop the copies of items
+    // that span several chunks while gathering them for drawing.
+    uint paintEpoch;
+    bool parallelAdvance;
+};
+
+// Work split into batches that the canvas thread and helper tasks from
+// the global thread pool take in turn, so the job finishes even if no
+// helper ever gets a thread. Helpers that start late find no batch left;
+// they share ownership of the job so that they never touch freed memory.
+class QtCanvasJob
+{
+public:
+    QtCanvasJob(int batches) : batches(batches) { }
+    virtual ~QtCanvasJob() { }
+
+    // Runs the next unclaimed batch; returns false if none was left.
+    bool runNext()
+    {
+        const int batch = next.fetchAndAddRelaxed(1);
+        if (batch >= batches)
+            return false;
+        runBatch(batch);
+        done.release();
+        return true;
+    }
+
+    const int batches;
+    QAtomicInt next;
+    QSemaphore done;
+
+protected:
+    virtual void runBatch(int batch) = 0;
+};
+
+class QtCanvasJobTask : public QRunnable
+{
+public:
+    QtCanvasJobTask(const QSharedPointer<QtCanvasJob> &job)
+        : m_job(job)
+    {
+    }
+
+    void run()
+    {
+        while (m_job->runNext())
+            ;
+    }
+
+private:
+    QSharedPointer<QtCanvasJob> m_job;
+};
+
+// Runs all batches of \a job and returns when they are done.
+static void qt_canvas_run_job(const QSharedPointer<QtCanvasJob> &job)
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    for (int i = 1; i < qMin(pool->maxThreadCount(), job->batches); ++i)
+        pool->start(new QtCanvasJobTask(job));
+    while (job->runNext())
+        ;
+    job->done.acquire(job->batches);
+}
+
+// Phase 0 of a parallel QtCanvas::advance().
+class QtCanvasAdvanceJob : public QtCanvasJob
+{
+public:
+    QtCanvasAdvanceJob(const QVector<QtCanvasItem *> &items, int batchSize)
+        : QtCanvasJob((items.size() + batchSize - 1)/batchSize),
+          m_items(items), m_batchSize(batchSize)
+    {
+    }
+
+protected:
+    void runBatch(int batch)
+    {
+        const int last = qMin((batch + 1)*m_batchSize, m_items.size());
+        for (int i = batch*m_batchSize; i < last; ++i)
+            m_items.at(i)->advance(0);
+    }
+
+private:
+    const QVector<QtCanvasItem *> m_items;
+    const int m_batchSize;
+};
+
+// A tile of a QtCanvasView, in view (rect) and canvas (area) coordinates,
+// with the items to draw back to front.
+struct QtCanvasTile
+{
+    QRect rect;
+    QRect area;
+    QVector<QtCanvasItem *> items;
+    QImage image;
+};
+
+// Rasterizes the tiles of a tiled QtCanvasView repaint, one per batch.
+class QtCanvasRenderJob : public QtCanvasJob
+{
+public:
+    QtCanvasRenderJob(QtCanvas *canvas, const QVector<QtCanvasTile> &tiles, const QMatrix &matrix,
+                      QPainter::RenderHints hints, qreal devicePixelRatio)
+        : QtCanvasJob(tiles.size()), tiles(tiles), m_canvas(canvas), m_tiles(this->tiles.data()),
+          m_matrix(matrix), m_hints(hints), m_devicePixelRatio(devicePixelRatio)
+    {
+    }
+
+    QVector<QtCanvasTile> tiles;
+
+protected:
+    void runBatch(int batch)
+    {
+        QtCanvasTile &tile = m_tiles[batch];
+        QImage image(tile.rect.size()*m_devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+        image.setDevicePixelRatio(m_devicePixelRatio);
+        image.fill(Qt::transparent);
+
+        QPainter painter(&image);
+        painter.setRenderHints(m_hints);
+        painter.translate(-tile.rect.topLeft());
+        painter.setMatrix(m_matrix, true);
+        m_canvas->drawBackground(painter, tile.area);
+        for (int i = 0; i < tile.items.size(); ++i)
+            tile.items.at(i)->draw(painter);
+        m_canvas->drawForeground(painter, tile.area);
+        painter.end();
+
+        tile.image = image;
+    }
+
+private:
+    QtCanvas *m_canvas;
+    // Detached up front; the tasks write to distinct tiles only.
+    QtCanvasTile *m_tiles;
+    const QMatrix m_matrix;
+    const QPainter::RenderHints m_hints;
+    const qreal m_devicePixelRatio;
 };
 
+static const int qt_canvas_advance_batch = 256;
+// Smallest view area, in pixels, worth splitting into tiles.
+static const int qt_canvas_tiled_area = 256*256;
+
 class QtCanvasViewData {
 public:
     QtCanvasViewData() {}
     QMatrix xform;
     QMatrix ixform;
     bool highQuality;
+    bool tiled;
 };
 
 // clusterizer
@@ -116,9 +422,9 @@ A QtCanvasClusterizer groups rectangles (QRects) into non-overlapping rectangles
 by a merging heuristic.
 */
 QtCanvasClusterizer::QtCanvasClusterizer(int maxclusters) :
-    cluster(new QRect[maxclusters]),
+    cluster(new QRect[qMax(1, maxclusters)]),
     count(0),
-    maxcl(maxclusters)
+    maxcl(qMax(1, maxclusters))
 { }
 
 QtCanvasClusterizer::~QtCanvasClusterizer()
@@ -193,26 +499,21 @@ void QtCanvasClusterizer::add(const QRect& rect)
     // Do cheapest of:
     //     add to closest cluster
     //     do cheapest cluster merge, add to new cluster
+    //
+    // At this point every choice may make clusters overlap; that only
+    // causes some area to be drawn twice.
 
-    lowestcost = 9999999;
-    cheapest = -1;
-    cursor = 0;
-    while(cursor < count) {
+    qint64 lowest = -1;
+    cheapest = 0;
+    for (cursor = 0; cursor < count; cursor++) {
         QRect larger = cluster[cursor];
         include(larger, rect);
-        int cost = larger.width()*larger.height()
-                - cluster[cursor].width()*cluster[cursor].height();
-        if (cost < lowestcost) {
-            bool bad = false;
-            for (int c = 0; c < count && !bad; c++) {
-                bad = cluster[c].intersects(larger) && c!= cursor;
-            }
-            if (!bad) {
-                cheapest = cursor;
-                lowestcost = cost;
-            }
+        qint64 cost = qint64(larger.width())*larger.height()
+                - qint64(cluster[cursor].width())*cluster[cursor].height();
+        if (lowest < 0 || cost < lowest) {
+            cheapest = cursor;
+            lowest = cost;
         }
-        cursor++;
     }
 
     // ###
@@ -222,45 +523,32 @@ void QtCanvasClusterizer::add(const QRect& rect)
     int cheapestmerge1 = -1;
     int cheapestmerge2 = -1;
 
-    int merge1 = 0;
-    while(merge1 < count) {
-        int merge2 = 0;
-        while(merge2 < count) {
-            if(merge1!= merge2) {
-                QRect larger = cluster[merge1];
-                include(larger, cluster[merge2]);
-                int cost = larger.width()*larger.height()
-                    - cluster[merge1].width()*cluster[merge1].height()
-                    - cluster[merge2].width()*cluster[merge2].height();
-                if (cost < lowestcost) {
-                    bool bad = false;
-                    for (int c = 0; c < count && !bad; c++) {
-                        bad = cluster[c].intersects(larger) && c!= cursor;
-                    }
-                    if (!bad) {
-                        cheapestmerge1 = merge1;
-                        cheapestmerge2 = merge2;
-                        lowestcost = cost;
-                    }
-                }
+    for (int merge1 = 0; merge1 < count; merge1++) {
+        for (int merge2 = merge1 + 1; merge2 < count; merge2++) {
+            QRect larger = cluster[merge1];
+            include(larger, cluster[merge2]);
+            qint64 cost = qint64(larger.width())*larger.height()
+                - qint64(cluster[merge1].width())*cluster[merge1].height()
+                - qint64(cluster[merge2].width())*cluster[merge2].height();
+            if (cost < lowest) {
+                cheapestmerge1 = merge1;
+                cheapestmerge2 = merge2;
+                lowest = cost;
             }
-            merge2++;
         }
-        merge1++;
     }
 
     if (cheapestmerge1>= 0) {
         include(cluster[cheapestmerge1], cluster[cheapestmerge2]);
-        cluster[cheapestmerge2] = cluster[count--];
+        cluster[cheapestmerge2] = cluster[--count];
+        cluster[count++] = rect;
     } else {
-        // if (!cheapest) debugRectangles(rect);
         include(cluster[cheapest], rect);
     }
 
-    // NB: clusters do not intersect (or intersection will
-    //     overwrite). This is a result of the above algorithm,
-    //     given the assumption that (x, y) are ordered topleft
-    //     to bottomright.
+    // NB: clusters do not intersect until maxcl clusters are in use.
+    //     This is a result of the above algorithm, given the
+    //     assumption that (x, y) are ordered topleft to bottomright.
 
     // ###
     //
@@ -287,10 +575,20 @@ public:
     }
 };
 
+// The reverse of QtCanvasItemLess, which orders items front to back.
+class QtCanvasItemBackToFront
+{
+public:
+    inline bool operator()(const QtCanvasItem *i1, const QtCanvasItem *i2) const
+    {
+        return QtCanvasItemLess()(i2, i1);
+    }
+};
+
 
 class QtCanvasChunk {
 public:
-    QtCanvasChunk() : changed(true) { }
+    QtCanvasChunk() : changed(false) { }
     // Other code assumes lists are not deleted. Assignment is also
     // done on ChunkRecs. So don't add that sort of thing here.
 
@@ -304,21 +602,25 @@ public:
         return m_list;
     }
 
-    void add(QtCanvasItem* item)
+    // add(), remove() and change() return true if the chunk was not
+    // already marked as changed.
+    bool add(QtCanvasItem* item)
     {
         m_list.prepend(item);
-        changed = true;
+        return change();
     }
 
-    void remove(QtCanvasItem* item)
+    bool remove(QtCanvasItem* item)
     {
         m_list.removeAll(item);
-        changed = true;
+        return change();
     }
 
-    void change()
+    bool change()
     {
+        bool y = !changed;
         changed = true;
+        return y;
     }
 
     bool hasChanged() const
@@ -527,6 +829,8 @@ void QtCanvas::init(int w, int h, int chunksze, int mxclusters)
     htiles = 0;
     vtiles = 0;
     debug_redraw_areas = false;
+    d->index.reset(chwidth, chheight, d->itemDict);
+    setAllChanged();
 }
 
 /*
@@ -652,6 +956,8 @@ void QtCanvas::resize(int w, int h)
     chheight = nchheight;
     delete [] chunks;
     chunks = newchunks;
+    d->changedChunks.clear();
+    d->index.reset(chwidth, chheight, d->itemDict);
 
     for (int i = 0; i < hidden.size(); ++i)
         hidden.at(i)->show();
@@ -727,9 +1033,13 @@ void QtCanvas::retune(int chunksze, int mxclusters)
         chheight = nchheight;
         delete [] chunks;
         chunks = newchunks;
+        d->changedChunks.clear();
+        d->index.reset(chwidth, chheight, d->itemDict);
 
         for (int i = 0; i < hidden.size(); ++i)
             hidden.at(i)->show();
+
+        setAllChanged();
     }
 }
 
@@ -818,6 +1128,7 @@ in the QtCanvas. The QtCanvasItem class calls this.
 void QtCanvas::addItem(QtCanvasItem* item)
 {
     d->itemDict.insert(item);
+    insertIntoZOrder(item);
 }
 
 /*
@@ -848,6 +1159,46 @@ in this QtCanvas. The QtCanvasItem class calls this.
 void QtCanvas::removeItem(QtCanvasItem* item)
 {
     d->itemDict.remove(item);
+    d->index.removeItem(item);
+    removeFromZOrder(item);
+}
+
+/*
+\internal
+This method moves the item \a item to its place for the z index \a z in
+the stacking order of the QtCanvas. The QtCanvasItem class calls this
+when an item's z changes.
+*/
+void QtCanvas::setItemZ(QtCanvasItem* item, double z)
+{
+    removeFromZOrder(item);
+    item->myz = z;
+    insertIntoZOrder(item);
+}
+
+/*
+\internal
+Inserts \a item into the back-to-front item order at the place its z
+index calls for.
+*/
+void QtCanvas::insertIntoZOrder(QtCanvasItem* item)
+{
+    QVector<QtCanvasItem *>::iterator it =
+        std::lower_bound(d->zOrder.begin(), d->zOrder.end(), item, QtCanvasItemBackToFront());
+    d->zOrder.insert(it, item);
+}
+
+/*
+\internal
+Removes \a item from the back-to-front item order. Its z index must
+not have changed since it was inserted.
+*/
+void QtCanvas::removeFromZOrder(QtCanvasItem* item)
+{
+    QVector<QtCanvasItem *>::iterator it =
+        std::lower_bound(d->zOrder.begin(), d->zOrder.end(), item, QtCanvasItemBackToFront());
+    if (it != d->zOrder.end() && *it == item)
+        d->zOrder.erase(it);
 }
 
 /*
@@ -938,27 +1289,67 @@ void QtCanvas::setUpdatePeriod(int ms)
     The canvas can be configured to call this function periodically
     with setAdvancePeriod().
 
+    If parallelAdvance() is enabled, phase 0 is spread over the
+    threads of the global QThreadPool. Phase 1, which moves the items
+    and updates the chunks, always runs on the canvas's thread.
+
     \sa update()
 */
 void QtCanvas::advance()
 {
-    QSetIterator<QtCanvasItem *> it = d->animDict;
-    while (it.hasNext()) {
-        QtCanvasItem *i = it.next();
-        if (i)
-            i->advance(0);
-    }
-    // we expect the dict contains the exact same items as in the
-    // first pass.
-    it.toFront();
-    while (it.hasNext()) {
-        QtCanvasItem* i = it.next();
-        if (i)
-            i->advance(1);
+    // we expect the dict contains the exact same items in both
+    // passes, even if phase 1 stops some animations.
+    QVector<QtCanvasItem *> items;
+    items.reserve(d->animDict.size());
+    for (QSet<QtCanvasItem *>::const_iterator it = d->animDict.constBegin(); it != d->animDict.constEnd(); ++it) {
+        if (*it)
+            items.append(*it);
+    }
+
+    const int threads = QThreadPool::globalInstance()->maxThreadCount();
+    if (d->parallelAdvance && threads > 1 && items.size() >= 2*qt_canvas_advance_batch) {
+        // Queries from phase 0 must find the collision index up to date.
+        d->index.update(this);
+        // A few batches per thread even out items that are slower to advance.
+        const int batchSize = qMax(qt_canvas_advance_batch, items.size()/(4*threads));
+        qt_canvas_run_job(QSharedPointer<QtCanvasJob>(new QtCanvasAdvanceJob(items, batchSize)));
+    } else {
+        for (int i = 0; i < items.size(); ++i)
+            items.at(i)->advance(0);
     }
+
+    for (int i = 0; i < items.size(); ++i)
+        items.at(i)->advance(1);
     update();
 }
 
+/*
+    Sets whether advance() calls QtCanvasItem::advance() with phase 0
+    on several threads at once to \a enable. This is off by default.
+
+    Only enable this if the phase 0 implementations of all animated
+    items are safe to call concurrently: they may read the canvas and
+    other items, for example with QtCanvasItem::collisions(), but must
+    not change anything except their own private state.
+    Small animations are always advanced on the canvas's thread.
+
+    \sa parallelAdvance(), advance()
+*/
+void QtCanvas::setParallelAdvance(bool enable)
+{
+    d->parallelAdvance = enable;
+}
+
+/*
+    Returns true if phase 0 of advance() may run on several threads.
+
+    \sa setParallelAdvance()
+*/
+bool QtCanvas::parallelAdvance() const
+{
+    return d->parallelAdvance;
+}
+
 // Don't call this unless you know what you're doing.
 // p is in the content's co-ordinate example.
 /*
@@ -971,10 +1362,84 @@ void QtCanvas::drawViewArea(QtCanvasView* view, QPainter* p, const QRect& vr, bo
     // ivr = covers all chunks in vr
     QRect ivr = iwm.mapRect(vr);
 
+    if (view->tiledRendering() && drawViewTiles(wm, p, vr))
+        return;
+
     p->setMatrix(wm);
     drawCanvasArea(ivr, p, false);
 }
 
+static int qt_floor_div(int a, int b)
+{
+    return a >= 0 ? a/b : -((b - 1 - a)/b);
+}
+
+/*
+  \internal
+  Draws the view area \a vr, mapped from the canvas by \a wm, as tiles
+  rasterized into images on the global thread pool and then drawn with
+  \a p. Returns false without drawing if \a vr is too small to be worth
+  splitting.
+*/
+bool QtCanvas::drawViewTiles(const QMatrix& wm, QPainter* p, const QRect& vr)
+{
+    const int threads = QThreadPool::globalInstance()->maxThreadCount();
+    if (threads < 2 || qint64(vr.width())*vr.height() < qt_canvas_tiled_area)
+        return false;
+
+    // Aim for a few tiles per thread, with edges on the chunk grid as it
+    // appears in the view.
+    const QRect chunkRect = wm.mapRect(QRect(0, 0, chunksize, chunksize));
+    const QPoint origin = wm.map(QPoint(0, 0));
+    const int side = qCeil(qSqrt(qreal(vr.width())*vr.height()/(4*threads)));
+    const int tilew = qMax(1, chunkRect.width())*qMax(1, side/qMax(1, chunkRect.width()));
+    const int tileh = qMax(1, chunkRect.height())*qMax(1, side/qMax(1, chunkRect.height()));
+
+    const QMatrix iwm = wm.inverted();
+    const QRect canvasRect(0, 0, width(), height());
+    QVector<QtCanvasTile> tiles;
+    const int x0 = origin.x() + qt_floor_div(vr.left() - origin.x(), tilew)*tilew;
+    const int y0 = origin.y() + qt_floor_div(vr.top() - origin.y(), tileh)*tileh;
+    const int columns = (vr.right() - x0)/tilew + 1;
+    for (int y = y0; y <= vr.bottom(); y += tileh) {
+        for (int x = x0; x <= vr.right(); x += tilew) {
+            QtCanvasTile tile;
+            tile.rect = QRect(x, y, tilew, tileh).intersected(vr);
+            tile.area = iwm.mapRect(tile.rect).intersected(canvasRect);
+            tiles.append(tile);
+        }
+    }
+
+    // Gather the items once for the whole area and hand each to the tiles
+    // its bounding rectangle touches in the view, which keeps every tile's
+    // list back to front. Gathering stamps the items, so it stays on this
+    // thread.
+    const QVector<QtCanvasItem *> items = visibleItems(iwm.mapRect(vr).intersected(canvasRect));
+    for (int i = 0; i < items.size(); ++i) {
+        QtCanvasItem *item = items.at(i);
+        // a pixel of slack for antialiased edges
+        const QRect r = wm.mapRect(item->boundingRect()).adjusted(-1, -1, 1, 1).intersected(vr);
+        if (r.isEmpty())
+            continue;
+        for (int ty = (r.top() - y0)/tileh; ty <= (r.bottom() - y0)/tileh; ++ty) {
+            for (int tx = (r.left() - x0)/tilew; tx <= (r.right() - x0)/tilew; ++tx) {
+                QtCanvasTile &tile = tiles[ty*columns + tx];
+                if (!tile.area.isEmpty())
+                    tile.items.append(item);
+            }
+        }
+    }
+
+    QSharedPointer<QtCanvasRenderJob> job(new QtCanvasRenderJob(this, tiles, wm, p->renderHints(),
+                                                                p->device()->devicePixelRatioF()));
+    tiles.clear();
+    qt_canvas_run_job(job);
+
+    for (int i = 0; i < job->tiles.size(); ++i)
+        p->drawImage(job->tiles.at(i).rect.topLeft(), job->tiles.at(i).image);
+    return true;
+}
+
 /*
     Repaints changed areas in all views of the canvas.
 
@@ -982,15 +1447,16 @@ void QtCanvas::drawViewArea(QtCanvasView* view, QPainter* p, const QRect& vr, bo
 */
 void QtCanvas::update()
 {
-    QRect r = changeBounds();
+    // changeBounds() also marks the chunks as unchanged.
+    const QVector<QRect> bands = changeBounds();
+    if (bands.isEmpty())
+        return;
     for (int i = 0; i < d->viewList.size(); ++i) {
         QtCanvasView* view = d->viewList.at(i);
-        if (!r.isEmpty()) {
-            QRect tr = view->worldMatrix().mapRect(r);
-            view->widget()->update(tr);
-        }
+        const QMatrix wm = view->worldMatrix();
+        for (int j = 0; j < bands.size(); ++j)
+            view->widget()->update(wm.mapRect(bands.at(j)));
     }
-    setUnchanged(r);
 }
 
 
@@ -1023,7 +1489,8 @@ void QtCanvas::setChanged(const QRect& area)
     while(x < mx) {
         int y = thearea.y()/chunksize;
         while(y < my) {
-            chunk(x, y).change();
+            if (chunk(x, y).change())
+                d->changedChunks.append(x+chwidth*y);
             y++;
         }
         x++;
@@ -1060,32 +1527,46 @@ void QtCanvas::setUnchanged(const QRect& area)
 
 /*
   \internal
-*/
-QRect QtCanvas::changeBounds()
-{
-    QRect area = QRect(0, 0, width(), height());
-
-    int mx = (area.x()+area.width()+chunksize)/chunksize;
-    int my = (area.y()+area.height()+chunksize)/chunksize;
-    if (mx > chwidth)
-        mx = chwidth;
-    if (my > chheight)
-        my = chheight;
-
-    QRect result;
-
-    int x = area.x()/chunksize;
-    while(x < mx) {
-        int y = area.y()/chunksize;
-        while(y < my) {
-            QtCanvasChunk& ch = chunk(x, y);
-            if (ch.hasChanged())
-                result |= QRect(x*chunksize, y*chunksize, chunksize + 1, chunksize + 1);
-            y++;
-        }
-        x++;
-    }
-
+  Returns the areas covered by the changed chunks and marks those chunks
+  as unchanged. Horizontal runs of changed chunks are grouped into at
+  most maxclusters rectangles, so that distant changes are repainted
+  separately instead of as one bounding rectangle.
+*/
+QVector<QRect> QtCanvas::changeBounds()
+{
+    // A chunk may be listed twice if it was marked unchanged with
+    // setUnchanged() and changed again; takeChange() skips the duplicate.
+    QVector<int> changed;
+    changed.reserve(d->changedChunks.size());
+    for (int i = 0; i < d->changedChunks.size(); ++i) {
+        const int index = d->changedChunks.at(i);
+        if (chunks[index].takeChange())
+            changed.append(index);
+    }
+    d->changedChunks.clear();
+
+    QVector<QRect> result;
+    if (changed.isEmpty())
+        return result;
+
+    // Chunk indices are row-major, so sorting them lines up the runs.
+    std::sort(changed.begin(), changed.end());
+
+    QtCanvasClusterizer clusterizer(maxclusters);
+    int i = 0;
+    while (i < changed.size()) {
+        const int first = changed.at(i);
+        int last = first;
+        while (++i < changed.size() && changed.at(i) == last+1 && (last+1)%chwidth != 0)
+            last++;
+        const int x = first%chwidth;
+        const int y = first/chwidth;
+        clusterizer.add(x*chunksize, y*chunksize, (last-first+1)*chunksize, chunksize);
+    }
+
+    result.reserve(clusterizer.clusters());
+    for (int c = 0; c < clusterizer.clusters(); c++)
+        result.append(clusterizer[c].adjusted(0, 0, 1, 1));
     return result;
 }
 
@@ -1118,6 +1599,20 @@ void QtCanvas::drawCanvasArea(const QRect& inarea, QPainter* p, bool /*double_bu
 
     if (!p) return; // Nothing to do.
 
+    const QVector<QtCanvasItem *> allvisible = visibleItems(area);
+
+    drawBackground(*p, area);
+    for (int i = 0; i < allvisible.size(); ++i)
+        allvisible.at(i)->draw(*p);
+    drawForeground(*p, area);
+}
+
+/*
+  \internal
+  Returns the items in the chunks covering \a area, back to front.
+*/
+QVector<QtCanvasItem *> QtCanvas::visibleItems(const QRect& area)
+{
     int lx = area.x()/chunksize;
     int ly = area.y()/chunksize;
     int mx = area.right()/chunksize;
@@ -1127,46 +1622,41 @@ void QtCanvas::drawCanvasArea(const QRect& inarea, QPainter* p, bool /*double_bu
     if (my>= chheight)
         my = chheight-1;
 
-    QtCanvasItemList allvisible;
-
-    // Stores the region within area that need to be drawn. It is relative
-    // to area.topLeft()  (so as to keep within bounds of 16-bit XRegions)
-    QRegion rgn;
+    if (++d->paintEpoch == 0) {
+        // Wrapped around; forget the old stamps.
+        for (int i = 0; i < d->zOrder.size(); ++i)
+            d->zOrder.at(i)->paintEpoch = 0;
+        d->paintEpoch = 1;
+    }
+    const uint epoch = d->paintEpoch;
 
+    // Items spanning several chunks are in each of their lists; keep the
+    // first copy only.
+    QVector<QtCanvasItem *> allvisible;
     for (int x = lx; x <= mx; x++) {
         for (int y = ly; y <= my; y++) {
-            // Only reset change if all views updating, and
-            // wholy within area. (conservative:  ignore entire boundary)
-            //
-            // Disable this to help debugging.
-            //
-            if (!p) {
-                if (chunk(x, y).takeChange()) {
-                    // ### should at least make bands
-                    rgn |= QRegion(x*chunksize-area.x(), y*chunksize-area.y(),
-                                   chunksize, chunksize);
-                    allvisible += chunk(x, y).list();
+            const QtCanvasItemList &list = chunk(x, y).list();
+            for (int i = 0; i < list.size(); ++i) {
+                QtCanvasItem *g = list.at(i);
+                if (g->paintEpoch != epoch) {
+                    g->paintEpoch = epoch;
+                    allvisible.append(g);
                 }
-            } else {
-                allvisible += chunk(x, y).list();
             }
         }
     }
-    qSort(allvisible.begin(), allvisible.end(), QtCanvasItemLess());
 
-    drawBackground(*p, area);
-    if (!allvisible.isEmpty()) {
-        QtCanvasItem* prev = 0;
-        for (int i = allvisible.size() - 1; i >= 0; --i) {
-            QtCanvasItem *g = allvisible[i];
-            if (g != prev) {
-                g->draw(*p);
-                prev = g;
-            }
-        }
+    // Pick the gathered items out of the back-to-front order instead of
+    // sorting them.
+    const int count = allvisible.size();
+    allvisible.clear();
+    allvisible.reserve(count);
+    for (int i = 0; i < d->zOrder.size() && allvisible.size() < count; ++i) {
+        QtCanvasItem *g = d->zOrder.at(i);
+        if (g->paintEpoch == epoch)
+            allvisible.append(g);
     }
-
-    drawForeground(*p, area);
+    return allvisible;
 }
 
 /*
@@ -1183,7 +1673,8 @@ void QtCanvas::setChangedChunk(int x, int y)
 {
     if (validChunk(x, y)) {
         QtCanvasChunk& ch = chunk(x, y);
-        ch.change();
+        if (ch.change())
+            d->changedChunks.append(x+chwidth*y);
     }
 }
 
@@ -1201,7 +1692,8 @@ void QtCanvas::setChangedChunkContaining(int x, int y)
 {
     if (x>= 0 && x < width() && y>= 0 && y < height()) {
         QtCanvasChunk& chunk = chunkContaining(x, y);
-        chunk.change();
+        if (chunk.change())
+            d->changedChunks.append(x/chunksize+chwidth*(y/chunksize));
     }
 }
 
@@ -1214,8 +1706,10 @@ chunk as `dirty'.
 */
 void QtCanvas::addItemToChunk(QtCanvasItem* g, int x, int y)
 {
+    d->index.markStale(g);
     if (validChunk(x, y)) {
-        chunk(x, y).add(g);
+        if (chunk(x, y).add(g))
+            d->changedChunks.append(x+chwidth*y);
     }
 }
 
@@ -1228,8 +1722,10 @@ as `dirty'.
 */
 void QtCanvas::removeItemFromChunk(QtCanvasItem* g, int x, int y)
 {
+    d->index.markStale(g);
     if (validChunk(x, y)) {
-        chunk(x, y).remove(g);
+        if (chunk(x, y).remove(g))
+            d->changedChunks.append(x+chwidth*y);
     }
 }
 
@@ -1243,8 +1739,10 @@ chunk as `dirty'.
 */
 void QtCanvas::addItemToChunkContaining(QtCanvasItem* g, int x, int y)
 {
+    d->index.markStale(g);
     if (x>= 0 && x < width() && y>= 0 && y < height()) {
-        chunkContaining(x, y).add(g);
+        if (chunkContaining(x, y).add(g))
+            d->changedChunks.append(x/chunksize+chwidth*(y/chunksize));
     }
 }
 
@@ -1257,8 +1755,10 @@ marks the chunk as `dirty'.
 */
 void QtCanvas::removeItemFromChunkContaining(QtCanvasItem* g, int x, int y)
 {
+    d->index.markStale(g);
     if (x>= 0 && x < width() && y>= 0 && y < height()) {
-        chunkContaining(x, y).remove(g);
+        if (chunkContaining(x, y).remove(g))
+            d->changedChunks.append(x/chunksize+chwidth*(y/chunksize));
     }
 }
 
@@ -1611,8 +2111,10 @@ class QtCanvasItemExtra {
 */
 QtCanvasItem::QtCanvasItem(QtCanvas* canvas) :
     cnv(canvas),
-    myx(0), myy(0), myz(0)
+    myx(0), myy(0), myz(0),
+    paintEpoch(0), indexLevel(-1)
 {
+    indexStale = 0;
     ani = 0;
     vis = 0;
     val = 0;
@@ -1681,13 +2183,21 @@ QtCanvasItemExtra& QtCanvasItem::extra()
 */
 
 /*
-    \fn void QtCanvasItem::setZ(double z)
-
     Sets the z index of the canvas item to \a z. Higher-z items
     obscure (are in front of) lower-z items.
 
     \sa z(), move()
 */
+void QtCanvasItem::setZ(double z)
+{
+    if (myz != z) {
+        if (cnv)
+            cnv->setItemZ(this, z);
+        else
+            myz = z;
+    }
+    changeChunks();
+}
 
 
 /*
@@ -1799,7 +2309,9 @@ double QtCanvasItem::yVelocity() const
 
     Note that if you reimplement this function, the reimplementation
     must not change the canvas in any way, for example it must not add
-    or remove items.
+    or remove items. If QtCanvas::parallelAdvance() is enabled, phase 0
+    may be called from a worker thread, concurrently with the phase 0
+    of other items.
 
     \sa QtCanvas::advance() setVelocity()
 */
@@ -2346,12 +2858,17 @@ QtCanvasItemList QtCanvas::collisions(const QPoint& p) const
 */
 QtCanvasItemList QtCanvas::collisions(const QRect& r) const
 {
-    QtCanvasRectangle i(r, (QtCanvas*)this);
+    const QRect area = r & rect();
+    if (!area.isValid())
+        return QtCanvasItemList();
+
+    // Not put on the canvas, so that the query does not touch the chunks.
+    QtCanvasRectangle i(r, 0);
     i.setPen(NoPen);
-    i.show(); // doesn't actually show, since we destroy it
-    QtCanvasItemList l = i.collisions(true);
-    qSort(l.begin(), l.end(), QtCanvasItemLess());
-    return l;
+    QPolygon chunklist;
+    chunklist << QPoint(area.left()/chunksize, area.top()/chunksize)
+              << QPoint(area.right()/chunksize, area.bottom()/chunksize);
+    return collisions(chunklist, &i, true);
 }
 
 /*
@@ -2363,31 +2880,32 @@ QtCanvasItemList QtCanvas::collisions(const QRect& r) const
     collide with\endlink \a item are returned; otherwise canvas items
     are included just for being in the chunks.
 
+    Candidates are looked up by the bounding rectangle of \a chunklist,
+    so when \a exact is false the result may include items that are in
+    other chunks within that rectangle. The list is ordered by z
+    coordinates, from highest z coordinate (front-most item) to lowest
+    z coordinate (rear-most item).
+
     This is a utility function mainly used to implement the simpler
     QtCanvasItem::collisions() function.
 */
 QtCanvasItemList QtCanvas::collisions(const QPolygon& chunklist, 
             const QtCanvasItem* item, bool exact) const
 {
-    QSet<QtCanvasItem *> seen;
-    QtCanvasItemList result;
-    for (int i = 0; i <(int)chunklist.count(); i++) {
-        int x = chunklist[i].x();
-        int y = chunklist[i].y();
-        if (validChunk(x, y)) {
-            const QtCanvasItemList &l = chunk(x, y).list();
-            for (int i = 0; i < l.size(); ++i) {
-                QtCanvasItem *g = l.at(i);
-                if (g != item) {
-                    if (!seen.contains(g)) {
-                        seen.insert(g);
-                        if (!exact || item->collidesWith(g))
-                            result.append(g);
-                    }
-                }
-            }
-        }
+    const QRect bounds = chunklist.boundingRect() & QRect(0, 0, chwidth, chheight);
+    if (chunklist.isEmpty() || !bounds.isValid())
+        return QtCanvasItemList();
+
+    d->index.update(this);
+    QtCanvasItemList result = d->index.items(bounds);
+    int n = 0;
+    for (int i = 0; i < result.size(); ++i) {
+        QtCanvasItem *g = result.at(i);
+        if (g != item && (!exact || item->collidesWith(g)))
+            result[n++] = g;
     }
+    result.erase(result.begin() + n, result.end());
+    std::sort(result.begin(), result.end(), QtCanvasItemLess());
     return result;
 }
 
@@ -3167,7 +3685,24 @@ void QtCanvasWidget::paintEvent(QPaintEvent *e)
         p.setRenderHint(QPainter::Antialiasing);
         p.setRenderHint(QPainter::SmoothPixmapTransform);
     }
-    m_view->drawContents(&p, e->rect().x(), e->rect().y(), e->rect().width(), e->rect().height());
+
+    // Draw the bands of a sparse update region separately; drawing the
+    // bounding rectangle would repaint everything between them.
+    const QRegion region = e->region();
+    const QRect bounds = region.boundingRect();
+    qint64 area = 0;
+    for (const QRect &r : region)
+        area += qint64(r.width())*r.height();
+    if (region.rectCount() > 1 && 2*area < qint64(bounds.width())*bounds.height()) {
+        for (const QRect &r : region) {
+            p.save();
+            p.setClipRect(r);
+            m_view->drawContents(&p, r.x(), r.y(), r.width(), r.height());
+            p.restore();
+        }
+        return;
+    }
+    m_view->drawContents(&p, bounds.x(), bounds.y(), bounds.width(), bounds.height());
 }
 
 /*
@@ -3181,6 +3716,7 @@ QtCanvasView::QtCanvasView(QWidget* parent)
     d = new QtCanvasViewData;
     setWidget(new QtCanvasWidget(this));
     d->highQuality = false;
+    d->tiled = false;
     viewing = 0;
     setCanvas(0);
 }
@@ -3196,6 +3732,7 @@ QtCanvasView::QtCanvasView(QtCanvas* canvas, QWidget* parent)
 {
     d = new QtCanvasViewData;
     d->highQuality = false;
+    d->tiled = false;
     setWidget(new QtCanvasWidget(this));
     viewing = 0;
     setCanvas(canvas);
@@ -3233,6 +3770,38 @@ void QtCanvasView::setHighQualityRendering(bool enable)
     widget()->update();
 }
 
+/*
+    \property QtCanvasView::tiledRendering
+    \brief whether large repaints are rasterized in tiles on several threads
+
+    If tiled rendering is turned on, large exposed areas of the view are
+    split into tiles aligned to the canvas's chunk grid. Each tile is
+    painted into its own QImage on the global QThreadPool, and the images
+    are then drawn to the view. Small areas are always painted directly.
+
+    Only turn this on if QtCanvas::drawBackground(),
+    QtCanvas::drawForeground() and the QtCanvasItem::draw() functions of
+    all items can be called from worker threads, concurrently with each
+    other. In particular, drawing a QPixmap, as the background tiles and
+    QtCanvasSprite do, requires a platform whose pixmaps can be used
+    outside the GUI thread, such as one with raster-backed pixmaps, and
+    drawing text, as QtCanvasText does, requires one that supports font
+    rendering outside the GUI thread (see
+    QFontDatabase::supportsThreadedFontRendering()).
+
+    This property is off by default.
+*/
+bool QtCanvasView::tiledRendering() const
+{
+    return d->tiled;
+}
+
+void QtCanvasView::setTiledRendering(bool enable)
+{
+    d->tiled = enable;
+    widget()->update();
+}
+
 
 void QtCanvasView::contentsMousePressEvent(QMouseEvent *e)
 {
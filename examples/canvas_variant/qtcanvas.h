@@ -45,6 +45,7 @@
 #include <QPen>
 #include <QPolygon>
 #include <QScrollArea>
+#include <QVector>
 
 class QtCanvasSprite;
 class QtCanvasPolygonalItem;
@@ -81,7 +82,7 @@ public:
     void move(double x, double y);
     void setX(double a) { move(a,y()); }
     void setY(double a) { move(x(),a); }
-    void setZ(double a) { myz=a; changeChunks(); }
+    void setZ(double a);
 
     bool animated() const;
     virtual void setAnimated(bool y);
@@ -158,6 +159,8 @@ private:
     friend class QtCanvasEllipse;
     friend class QtCanvasText;
     friend class QtCanvasLine;
+    friend class QtCanvas;
+    friend class QtCanvasItemIndex;
 
     virtual QPolygon chunks() const;
     virtual void addToChunks();
@@ -175,6 +178,10 @@ private:
     double myx,myy,myz;
     QtCanvasItemExtra *ext;
     QtCanvasItemExtra& extra();
+    uint paintEpoch; // QtCanvas::drawCanvasArea() pass that gathered the item
+    QRect indexBounds; // chunks covered, as last indexed for collisions
+    int indexLevel; // grid level in the collision index, or -1
+    uint indexStale:1;
     uint ani:1;
     uint vis:1;
     uint val:1;
@@ -274,10 +281,14 @@ public:
     virtual void addAnimation(QtCanvasItem*);
     virtual void removeItem(QtCanvasItem*);
     virtual void removeAnimation(QtCanvasItem*);
+    void setItemZ(QtCanvasItem*, double z);
 
     virtual void setAdvancePeriod(int ms);
     virtual void setUpdatePeriod(int ms);
 
+    virtual void setParallelAdvance(bool enable);
+    bool parallelAdvance() const;
+
 signals:
     void resized();
 
@@ -295,7 +306,12 @@ private:
     QtCanvasChunk& chunk(int i, int j) const;
     QtCanvasChunk& chunkContaining(int x, int y) const;
 
-    QRect changeBounds();
+    void insertIntoZOrder(QtCanvasItem*);
+    void removeFromZOrder(QtCanvasItem*);
+    QVector<QtCanvasItem *> visibleItems(const QRect& area);
+    bool drawViewTiles(const QMatrix& wm, QPainter* p, const QRect& vr);
+
+    QVector<QRect> changeBounds();
 
     int awidth,aheight;
     int chunksize;
@@ -318,6 +334,7 @@ private:
     bool debug_redraw_areas;
 
     friend void qt_unview(QtCanvas* c);
+    friend class QtCanvasRenderJob;
 
     Q_DISABLE_COPY(QtCanvas)
 };
@@ -328,6 +345,7 @@ class QtCanvasView : public QScrollArea
 {
     Q_OBJECT
     Q_PROPERTY(bool highQualityRendering READ highQualityRendering WRITE setHighQualityRendering)
+    Q_PROPERTY(bool tiledRendering READ tiledRendering WRITE setTiledRendering)
 public:
 
     QtCanvasView(QWidget* parent=0);
@@ -345,8 +363,10 @@ public:
     virtual QSize sizeHint() const;
 
     bool highQualityRendering() const;
+    bool tiledRendering() const;
 public slots:
     void setHighQualityRendering(bool enable);
+    void setTiledRendering(bool enable);
     
 protected:
     friend class QtCanvasWidget;
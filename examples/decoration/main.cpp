@@ -106,7 +106,7 @@ void DecoratedDoublePropertyManager::setPrefix(QtProperty *property, const QStri
     data.prefix = prefix;
     propertyToData[property] = data;
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit prefixChanged(property, prefix);
 }
 
@@ -122,7 +122,7 @@ void DecoratedDoublePropertyManager::setSuffix(QtProperty *property, const QStri
     data.suffix = suffix;
     propertyToData[property] = data;
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit suffixChanged(property, suffix);
 }
 
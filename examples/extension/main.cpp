@@ -163,7 +163,7 @@ void VariantManager::setValue(QtProperty *property, const QVariant &val)
         if (d.y)
             d.y->setValue(p.y());
         propertyToData[property] = d;
-        emit propertyChanged(property);
+        notifyPropertyChanged(property);
         emit valueChanged(property, p);
         return;
     }
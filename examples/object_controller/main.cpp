@@ -52,7 +52,7 @@
 #include <QTextDocument>
 #include <QCalendarWidget>
 #include <QTimeLine>
-#include "objectcontroller.h"
+#include "qtobjectcontroller.h"
 
 class MyController : public QDialog
 {
@@ -64,7 +64,7 @@ private slots:
     void createAndControl();
 private:
     QComboBox *theClassCombo;
-    ObjectController *theController;
+    QtObjectController *theController;
     QStringList theClassNames;
     QObject *theControlledObject;
 };
@@ -74,7 +74,7 @@ MyController::MyController(QWidget *parent)
 {
     theClassCombo = new QComboBox(this);
     QToolButton *button = new QToolButton(this);
-    theController = new ObjectController(this);
+    theController = new QtObjectController(this);
     QDialogButtonBox *buttonBox = new QDialogButtonBox(this);
 
     connect(button, SIGNAL(clicked()), this, SLOT(createAndControl()));
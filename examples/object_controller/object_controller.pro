@@ -4,6 +4,5 @@ INCLUDEPATH += .
 
 include(../../src/qtpropertybrowser.pri)
 # Input
-HEADERS += objectcontroller.h
-SOURCES += objectcontroller.cpp main.cpp
+SOURCES += main.cpp
 
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qtbuttonpropertybrowser.h"
+#include "qtpropertybrowserutils_p.h"
 #include <QtCore/QSet>
 #include <QtWidgets/QGridLayout>
 #include <QtWidgets/QLabel>
@@ -53,14 +54,18 @@ class QtButtonPropertyBrowserPrivate
     QtButtonPropertyBrowser *q_ptr;
     Q_DECLARE_PUBLIC(QtButtonPropertyBrowser)
 public:
+    QtButtonPropertyBrowserPrivate() : m_mainLayout(0), m_rowView(0) {}
 
     void init(QWidget *parent);
+    void setWidgetFree(bool widgetFree);
 
     void propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex);
     void propertyRemoved(QtBrowserItem *index);
     void propertyChanged(QtBrowserItem *index);
     QWidget *createEditor(QtProperty *property, QWidget *parent) const
         { return q_ptr->createEditor(property, parent); }
+    bool hasEditorFactory(QtProperty *property) const
+        { return q_ptr->hasEditorFactory(property); }
 
     void slotEditorDestroyed();
     void slotUpdate();
@@ -87,6 +92,9 @@ private:
     int gridSpan(WidgetItem *item) const;
     void setExpanded(WidgetItem *item, bool expanded);
     QToolButton *createButton(QWidget *panret = 0) const;
+    void insertItems(QtBrowserItem *index, QtBrowserItem *afterIndex);
+    void removeItems(QtBrowserItem *index);
+    void collectExpanded(QtBrowserItem *index, QList<QtBrowserItem *> *expanded) const;
 
     QMap<QtBrowserItem *, WidgetItem *> m_indexToItem;
     QMap<WidgetItem *, QtBrowserItem *> m_itemToIndex;
@@ -95,6 +103,31 @@ private:
     QGridLayout *m_mainLayout;
     QList<WidgetItem *> m_children;
     QList<WidgetItem *> m_recreateQueue;
+    QtPropertyRowView *m_rowView; // set in widget-free mode
+};
+
+class QtButtonRowView : public QtPropertyRowView
+{
+public:
+    QtButtonRowView(QtButtonPropertyBrowserPrivate *browserPrivate, QtButtonPropertyBrowser *browser)
+        : QtPropertyRowView(browser, ButtonGroups, browser), m_browserPrivate(browserPrivate), m_browser(browser) {}
+
+protected:
+    QWidget *createEditor(QtProperty *property, QWidget *parent)
+        { return m_browserPrivate->createEditor(property, parent); }
+    bool isEditable(QtProperty *property) const
+        { return m_browserPrivate->hasEditorFactory(property); }
+    void expandedChanged(QtBrowserItem *item, bool expanded)
+    {
+        if (expanded)
+            emit m_browser->expanded(item);
+        else
+            emit m_browser->collapsed(item);
+    }
+
+private:
+    QtButtonPropertyBrowserPrivate *m_browserPrivate;
+    QtButtonPropertyBrowser *m_browser;
 };
 
 QToolButton *QtButtonPropertyBrowserPrivate::createButton(QWidget *parent) const
@@ -147,6 +180,68 @@ void QtButtonPropertyBrowserPrivate::init(QWidget *parent)
     m_mainLayout->addItem(item, 0, 0);
 }
 
+void QtButtonPropertyBrowserPrivate::setWidgetFree(bool widgetFree)
+{
+    if (widgetFree == (m_rowView != 0))
+        return;
+
+    // take all items down and rebuild them in the other mode, keeping
+    // the expanded buttons expanded
+    const QList<QtBrowserItem *> items = q_ptr->topLevelItems();
+    QList<QtBrowserItem *> expanded;
+    for (QtBrowserItem *item : items)
+        collectExpanded(item, &expanded);
+    for (auto it = items.crbegin(), rend = items.crend(); it != rend; ++it)
+        removeItems(*it);
+
+    if (widgetFree) {
+        m_rowView = new QtButtonRowView(this, q_ptr);
+        insertRow(m_mainLayout, 0);
+        m_mainLayout->addWidget(m_rowView, 0, 0, 1, 2);
+    } else {
+        m_mainLayout->removeWidget(m_rowView);
+        delete m_rowView;
+        m_rowView = 0;
+        removeRow(m_mainLayout, 0);
+    }
+
+    QtBrowserItem *afterItem = 0;
+    for (QtBrowserItem *item : items) {
+        insertItems(item, afterItem);
+        afterItem = item;
+    }
+    for (QtBrowserItem *item : qAsConst(expanded))
+        q_ptr->setExpanded(item, true);
+}
+
+void QtButtonPropertyBrowserPrivate::insertItems(QtBrowserItem *index, QtBrowserItem *afterIndex)
+{
+    propertyInserted(index, afterIndex);
+    QtBrowserItem *afterChild = 0;
+    const auto children = index->children();
+    for (QtBrowserItem *child : children) {
+        insertItems(child, afterChild);
+        afterChild = child;
+    }
+}
+
+void QtButtonPropertyBrowserPrivate::removeItems(QtBrowserItem *index)
+{
+    const auto children = index->children();
+    for (int i = children.count(); i > 0; i--)
+        removeItems(children.at(i - 1));
+    propertyRemoved(index);
+}
+
+void QtButtonPropertyBrowserPrivate::collectExpanded(QtBrowserItem *index, QList<QtBrowserItem *> *expanded) const
+{
+    if (q_ptr->isExpanded(index))
+        expanded->append(index);
+    const auto children = index->children();
+    for (QtBrowserItem *child : children)
+        collectExpanded(child, expanded);
+}
+
 void QtButtonPropertyBrowserPrivate::slotEditorDestroyed()
 {
     QWidget *editor = qobject_cast<QWidget *>(q_ptr->sender());
@@ -237,6 +332,11 @@ void QtButtonPropertyBrowserPrivate::updateLater()
 
 void QtButtonPropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex)
 {
+    if (m_rowView) {
+        m_rowView->itemInserted(index);
+        return;
+    }
+
     WidgetItem *afterItem = m_indexToItem.value(afterIndex);
     WidgetItem *parentItem = m_indexToItem.value(index->parent());
 
@@ -327,6 +427,11 @@ void QtButtonPropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, QtBr
 
 void QtButtonPropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
 {
+    if (m_rowView) {
+        m_rowView->itemRemoved(index);
+        return;
+    }
+
     WidgetItem *item = m_indexToItem.value(index);
 
     m_indexToItem.remove(index);
@@ -437,6 +542,11 @@ void QtButtonPropertyBrowserPrivate::removeRow(QGridLayout *layout, int row) con
 
 void QtButtonPropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
 {
+    if (m_rowView) {
+        m_rowView->itemChanged(index);
+        return;
+    }
+
     WidgetItem *item = m_indexToItem.value(index);
 
     updateItem(item);
@@ -514,6 +624,28 @@ void QtButtonPropertyBrowserPrivate::updateItem(WidgetItem *item)
     \sa QtTreePropertyBrowser, QtAbstractPropertyBrowser
 */
 
+/*!
+    \property QtButtonPropertyBrowser::widgetFree
+    \brief whether the rows are painted instead of being built from widgets.
+
+    By default every property gets a label, a value label or editor,
+    and every property with subproperties a drop down button and a
+    container, all held in nested grid layouts. In widget-free mode
+    the rows, buttons and containers are painted with the current style
+    instead, and only the row the user clicks gets a real editor, so
+    the cost of a browser depends on the rows on screen rather than on
+    the number of properties.
+*/
+bool QtButtonPropertyBrowser::isWidgetFree() const
+{
+    return d_ptr->m_rowView != 0;
+}
+
+void QtButtonPropertyBrowser::setWidgetFree(bool widgetFree)
+{
+    d_ptr->setWidgetFree(widgetFree);
+}
+
 /*!
     \fn void QtButtonPropertyBrowser::collapsed(QtBrowserItem *item)
 
@@ -590,6 +722,10 @@ void QtButtonPropertyBrowser::itemChanged(QtBrowserItem *item)
 
 void QtButtonPropertyBrowser::setExpanded(QtBrowserItem *item, bool expanded)
 {
+    if (d_ptr->m_rowView) {
+        d_ptr->m_rowView->setExpanded(item, expanded);
+        return;
+    }
     QtButtonPropertyBrowserPrivate::WidgetItem *itm = d_ptr->m_indexToItem.value(item);
     if (itm)
         d_ptr->setExpanded(itm, expanded);
@@ -603,6 +739,8 @@ void QtButtonPropertyBrowser::setExpanded(QtBrowserItem *item, bool expanded)
 
 bool QtButtonPropertyBrowser::isExpanded(QtBrowserItem *item) const
 {
+    if (d_ptr->m_rowView)
+        return d_ptr->m_rowView->isExpanded(item);
     QtButtonPropertyBrowserPrivate::WidgetItem *itm = d_ptr->m_indexToItem.value(item);
     if (itm)
         return itm->expanded;
@@ -49,11 +49,15 @@ class QtButtonPropertyBrowserPrivate;
 class QtButtonPropertyBrowser : public QtAbstractPropertyBrowser
 {
     Q_OBJECT
+    Q_PROPERTY(bool widgetFree READ isWidgetFree WRITE setWidgetFree)
 public:
 
     QtButtonPropertyBrowser(QWidget *parent = 0);
     ~QtButtonPropertyBrowser();
 
+    bool isWidgetFree() const;
+    void setWidgetFree(bool widgetFree);
+
     void setExpanded(QtBrowserItem *item, bool expanded);
     bool isExpanded(QtBrowserItem *item) const;
 
@@ -48,6 +48,7 @@
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QMenu>
 #include <QtGui/QKeyEvent>
+#include <QtGui/QRegularExpressionValidator>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QToolButton>
@@ -56,6 +57,11 @@
 #include <QtWidgets/QSpacerItem>
 #include <QtWidgets/QKeySequenceEdit>
 #include <QtCore/QMap>
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QRegularExpression>
 
 #if defined(Q_CC_MSVC)
 #    pragma warning(disable: 4786) /* MS VS 6: truncating debug info after 255 characters */
@@ -75,8 +81,32 @@ static inline void setupTreeViewEditorMargin(QLayout *lt)
         lt->setContentsMargins(0, 0, DecorationMargin, 0);
 }
 
+// Sliders stop reporting values until they are released on their own.
+// Spin boxes report every arrow, wheel and page step, so their factories
+// hold the values back until editing finished.
+static inline bool holdsValuesUntilRelease(const QAbstractSlider *)
+{
+    return false;
+}
+
+static inline bool holdsValuesUntilRelease(const QAbstractSpinBox *)
+{
+    return true;
+}
+
+static inline void setCommitOnRelease(QAbstractSlider *editor, bool onRelease)
+{
+    editor->setTracking(!onRelease);
+}
+
+static inline void setCommitOnRelease(QAbstractSpinBox *, bool)
+{
+}
+
 // ---------- EditorFactoryPrivate :
 // Base class for editor factory private classes. Manages mapping of properties to editors and vice versa.
+// Factories of numeric editors also implement the commit policy of QtAbstractEditorFactoryBase with it:
+// they call initCommitPolicy(), applyCommitPolicies() and holdCommit(), and reimplement commitValue().
 
 template <class Editor>
 class EditorFactoryPrivate
@@ -87,12 +117,31 @@ public:
     typedef QMap<QtProperty *, EditorList> PropertyToEditorListMap;
     typedef QMap<Editor *, QtProperty *> EditorToPropertyMap;
 
+    virtual ~EditorFactoryPrivate() {}
+
     Editor *createEditor(QtProperty *property, QWidget *parent);
     void initializeEditor(QtProperty *property, Editor *e);
     void slotEditorDestroyed(QObject *object);
 
+    void initCommitPolicy(QtAbstractEditorFactoryBase *factory);
+    QtAbstractEditorFactoryBase::CommitPolicy commitPolicy(const QtProperty *property) const;
+    void applyCommitPolicy(Editor *editor, const QtProperty *property);
+    void applyCommitPolicies(const QtProperty *property);
+    bool holdCommit(Editor *editor, const QVariant &value);
+    void commitHeld(Editor *editor);
+    virtual void commitValue(QtProperty *property, const QVariant &value);
+    void slotCommitPending();
+
     PropertyToEditorListMap  m_createdEditors;
     EditorToPropertyMap m_editorToProperty;
+
+    QtAbstractEditorFactoryBase *m_factory{0};
+    QTimer *m_commitTimer{0};
+    QElapsedTimer m_commitClock;
+    // values held back by the commit policy, and when each throttled
+    // editor last committed
+    QMap<Editor *, QVariant> m_pendingCommits;
+    QHash<Editor *, qint64> m_lastCommits;
 };
 
 template <class Editor>
@@ -128,25 +177,163 @@ void EditorFactoryPrivate<Editor>::slotEditorDestroyed(QObject *object)
                     m_createdEditors.erase(pit);
             }
             m_editorToProperty.erase(itEditor);
+            m_lastCommits.remove(editor);
+
+            // do not lose a value held back by the commit policy
+            const typename QMap<Editor *, QVariant>::iterator cit = m_pendingCommits.find(editor);
+            if (cit != m_pendingCommits.end()) {
+                const QVariant value = cit.value();
+                m_pendingCommits.erase(cit);
+                commitValue(property, value);
+            }
             return;
         }
     }
 }
 
+template <class Editor>
+void EditorFactoryPrivate<Editor>::initCommitPolicy(QtAbstractEditorFactoryBase *factory)
+{
+    m_factory = factory;
+    m_commitTimer = new QTimer(factory);
+    m_commitTimer->setSingleShot(true);
+    QObject::connect(m_commitTimer, SIGNAL(timeout()), factory, SLOT(slotCommitPending()));
+}
+
+template <class Editor>
+QtAbstractEditorFactoryBase::CommitPolicy EditorFactoryPrivate<Editor>::commitPolicy(const QtProperty *property) const
+{
+    return m_factory ? m_factory->commitPolicy(property) : QtAbstractEditorFactoryBase::CommitImmediately;
+}
+
+template <class Editor>
+void EditorFactoryPrivate<Editor>::applyCommitPolicy(Editor *editor, const QtProperty *property)
+{
+    setCommitOnRelease(editor, commitPolicy(property) == QtAbstractEditorFactoryBase::CommitOnRelease);
+}
+
+// Applies a changed policy to the open editors of \a property, or of all
+// properties if it is 0, and commits what the old policy held back.
+template <class Editor>
+void EditorFactoryPrivate<Editor>::applyCommitPolicies(const QtProperty *property)
+{
+    const typename EditorToPropertyMap::const_iterator ecend = m_editorToProperty.constEnd();
+    for (typename EditorToPropertyMap::const_iterator it = m_editorToProperty.constBegin(); it != ecend; ++it) {
+        if (!property || it.value() == property) {
+            applyCommitPolicy(it.key(), it.value());
+            commitHeld(it.key());
+        }
+    }
+}
+
+// Returns true if the value must not be committed now. Throttled editors
+// commit their first change at once and the latest one when their own
+// interval has elapsed; spin boxes on CommitOnRelease commit when editing
+// finished, see commitHeld().
+template <class Editor>
+bool EditorFactoryPrivate<Editor>::holdCommit(Editor *editor, const QVariant &value)
+{
+    const QtAbstractEditorFactoryBase::CommitPolicy policy = commitPolicy(m_editorToProperty.value(editor, 0));
+    if (policy == QtAbstractEditorFactoryBase::CommitOnRelease && holdsValuesUntilRelease(editor)) {
+        m_pendingCommits[editor] = value;
+        return true;
+    }
+    if (policy != QtAbstractEditorFactoryBase::CommitThrottled || !m_commitTimer)
+        return false;
+
+    if (!m_commitClock.isValid())
+        m_commitClock.start();
+    const qint64 now = m_commitClock.elapsed();
+    const qint64 interval = 1000 / m_factory->commitRate();
+    const typename QHash<Editor *, qint64>::iterator it = m_lastCommits.find(editor);
+    if (it == m_lastCommits.end() || now - it.value() >= interval) {
+        // leading edge of this editor: commit, hold back the following ones
+        m_lastCommits[editor] = now;
+        m_pendingCommits.remove(editor);
+        return false;
+    }
+    m_pendingCommits[editor] = value;
+    if (!m_commitTimer->isActive())
+        m_commitTimer->start(int(interval - (now - it.value())));
+    return true;
+}
+
+template <class Editor>
+void EditorFactoryPrivate<Editor>::commitHeld(Editor *editor)
+{
+    const typename QMap<Editor *, QVariant>::iterator it = m_pendingCommits.find(editor);
+    if (it == m_pendingCommits.end())
+        return;
+    const QVariant value = it.value();
+    m_pendingCommits.erase(it);
+    if (QtProperty *property = m_editorToProperty.value(editor, 0)) {
+        if (m_lastCommits.contains(editor))
+            m_lastCommits[editor] = m_commitClock.elapsed();
+        commitValue(property, value);
+    }
+}
+
+template <class Editor>
+void EditorFactoryPrivate<Editor>::commitValue(QtProperty *, const QVariant &)
+{
+}
+
+// Commits the throttled values whose interval has elapsed, and waits for
+// the next one due.
+template <class Editor>
+void EditorFactoryPrivate<Editor>::slotCommitPending()
+{
+    const qint64 interval = 1000 / m_factory->commitRate();
+    qint64 wait = -1;
+    const QList<Editor *> editors = m_pendingCommits.keys();
+    for (Editor *editor : editors) {
+        if (commitPolicy(m_editorToProperty.value(editor, 0)) != QtAbstractEditorFactoryBase::CommitThrottled)
+            continue;
+        const qint64 left = interval - (m_commitClock.elapsed() - m_lastCommits.value(editor));
+        if (left <= 0)
+            commitHeld(editor);
+        else if (wait < 0 || left < wait)
+            wait = left;
+    }
+    if (wait >= 0)
+        m_commitTimer->start(int(wait));
+}
+
+// Shared by the factories that listen to their managers: passes the value of a changed
+// property on to its editors. The factory only registers with managers of PropertyManager.
+template <class PropertyManager, class FactoryPrivate>
+static void forwardValueChange(FactoryPrivate *d, const QtPropertyChange &change)
+{
+    if (change.type != QtPropertyChange::Changed || !d->m_createdEditors.contains(change.property))
+        return;
+    const PropertyManager *manager = static_cast<const PropertyManager *>(change.property->propertyManager());
+    d->slotPropertyChanged(change.property, manager->value(change.property));
+}
+
 // ------------ QtSpinBoxFactory
 
-class QtSpinBoxFactoryPrivate : public EditorFactoryPrivate<QSpinBox>
+class QtSpinBoxFactoryPrivate : public EditorFactoryPrivate<QSpinBox>, public QtPropertyChangeListener
 {
     QtSpinBoxFactory *q_ptr;
     Q_DECLARE_PUBLIC(QtSpinBoxFactory)
 public:
+    void propertyChangeEvent(const QtPropertyChange &change);
 
     void slotPropertyChanged(QtProperty *property, int value);
     void slotRangeChanged(QtProperty *property, int min, int max);
     void slotSingleStepChanged(QtProperty *property, int step);
     void slotSetValue(int value);
+    void slotEditingFinished();
+    void commitValue(QtProperty *property, const QVariant &value);
 };
 
+void QtSpinBoxFactoryPrivate::propertyChangeEvent(const QtPropertyChange &change)
+{
+    if (change.type == QtPropertyChange::Destroyed)
+        q_ptr->removeCommitPolicy(change.property);
+    forwardValueChange<QtIntPropertyManager>(this, change);
+}
+
 void QtSpinBoxFactoryPrivate::slotPropertyChanged(QtProperty *property, int value)
 {
     const auto it = m_createdEditors.constFind(property);
@@ -197,16 +384,25 @@ void QtSpinBoxFactoryPrivate::slotSetValue(int value)
     const QMap<QSpinBox *, QtProperty *>::ConstIterator  ecend = m_editorToProperty.constEnd();
     for (QMap<QSpinBox *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor !=  ecend; ++itEditor) {
         if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtIntPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
+            if (!holdCommit(itEditor.key(), value))
+                commitValue(itEditor.value(), value);
             return;
         }
     }
 }
 
+void QtSpinBoxFactoryPrivate::slotEditingFinished()
+{
+    if (QSpinBox *editor = qobject_cast<QSpinBox *>(q_ptr->sender()))
+        commitHeld(editor);
+}
+
+void QtSpinBoxFactoryPrivate::commitValue(QtProperty *property, const QVariant &value)
+{
+    if (QtIntPropertyManager *manager = q_ptr->propertyManager(property))
+        manager->setValue(property, value.toInt());
+}
+
 /*!
     \class QtSpinBoxFactory
     \internal
@@ -226,6 +422,7 @@ QtSpinBoxFactory::QtSpinBoxFactory(QObject *parent)
     : QtAbstractEditorFactory<QtIntPropertyManager>(parent), d_ptr(new QtSpinBoxFactoryPrivate())
 {
     d_ptr->q_ptr = this;
+    d_ptr->initCommitPolicy(this);
 
 }
 
@@ -234,9 +431,19 @@ QtSpinBoxFactory::QtSpinBoxFactory(QObject *parent)
 */
 QtSpinBoxFactory::~QtSpinBoxFactory()
 {
+    for (QtIntPropertyManager *manager : propertyManagers())
+        manager->removeListener(d_ptr.data());
     qDeleteAll(d_ptr->m_editorToProperty.keys());
 }
 
+/*!
+    \reimp
+*/
+void QtSpinBoxFactory::commitPolicyChanged(const QtProperty *property)
+{
+    d_ptr->applyCommitPolicies(property);
+}
+
 /*!
     \internal
 
@@ -244,8 +451,7 @@ QtSpinBoxFactory::~QtSpinBoxFactory()
 */
 void QtSpinBoxFactory::connectPropertyManager(QtIntPropertyManager *manager)
 {
-    connect(manager, SIGNAL(valueChanged(QtProperty*,int)),
-                this, SLOT(slotPropertyChanged(QtProperty*,int)));
+    manager->addListener(d_ptr.data());
     connect(manager, SIGNAL(rangeChanged(QtProperty*,int,int)),
                 this, SLOT(slotRangeChanged(QtProperty*,int,int)));
     connect(manager, SIGNAL(singleStepChanged(QtProperty*,int)),
@@ -266,7 +472,10 @@ QWidget *QtSpinBoxFactory::createEditor(QtIntPropertyManager *manager, QtPropert
     editor->setValue(manager->value(property));
     editor->setKeyboardTracking(false);
 
+    d_ptr->applyCommitPolicy(editor, property);
+
     connect(editor, SIGNAL(valueChanged(int)), this, SLOT(slotSetValue(int)));
+    connect(editor, SIGNAL(editingFinished()), this, SLOT(slotEditingFinished()));
     connect(editor, SIGNAL(destroyed(QObject*)),
                 this, SLOT(slotEditorDestroyed(QObject*)));
     return editor;
@@ -279,8 +488,7 @@ QWidget *QtSpinBoxFactory::createEditor(QtIntPropertyManager *manager, QtPropert
 */
 void QtSpinBoxFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 {
-    disconnect(manager, SIGNAL(valueChanged(QtProperty*,int)),
-                this, SLOT(slotPropertyChanged(QtProperty*,int)));
+    manager->removeListener(d_ptr.data());
     disconnect(manager, SIGNAL(rangeChanged(QtProperty*,int,int)),
                 this, SLOT(slotRangeChanged(QtProperty*,int,int)));
     disconnect(manager, SIGNAL(singleStepChanged(QtProperty*,int)),
@@ -289,17 +497,26 @@ void QtSpinBoxFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 
 // QtSliderFactory
 
-class QtSliderFactoryPrivate : public EditorFactoryPrivate<QSlider>
+class QtSliderFactoryPrivate : public EditorFactoryPrivate<QSlider>, public QtPropertyChangeListener
 {
     QtSliderFactory *q_ptr;
     Q_DECLARE_PUBLIC(QtSliderFactory)
 public:
+    void propertyChangeEvent(const QtPropertyChange &change);
     void slotPropertyChanged(QtProperty *property, int value);
     void slotRangeChanged(QtProperty *property, int min, int max);
     void slotSingleStepChanged(QtProperty *property, int step);
     void slotSetValue(int value);
+    void commitValue(QtProperty *property, const QVariant &value);
 };
 
+void QtSliderFactoryPrivate::propertyChangeEvent(const QtPropertyChange &change)
+{
+    if (change.type == QtPropertyChange::Destroyed)
+        q_ptr->removeCommitPolicy(change.property);
+    forwardValueChange<QtIntPropertyManager>(this, change);
+}
+
 void QtSliderFactoryPrivate::slotPropertyChanged(QtProperty *property, int value)
 {
     const auto it = m_createdEditors.constFind(property);
@@ -348,16 +565,19 @@ void QtSliderFactoryPrivate::slotSetValue(int value)
     const QMap<QSlider *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
     for (QMap<QSlider *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor ) {
         if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtIntPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
+            if (!holdCommit(itEditor.key(), value))
+                commitValue(itEditor.value(), value);
             return;
         }
     }
 }
 
+void QtSliderFactoryPrivate::commitValue(QtProperty *property, const QVariant &value)
+{
+    if (QtIntPropertyManager *manager = q_ptr->propertyManager(property))
+        manager->setValue(property, value.toInt());
+}
+
 /*!
     \class QtSliderFactory
     \internal
@@ -377,6 +597,7 @@ QtSliderFactory::QtSliderFactory(QObject *parent)
     : QtAbstractEditorFactory<QtIntPropertyManager>(parent), d_ptr(new QtSliderFactoryPrivate())
 {
     d_ptr->q_ptr = this;
+    d_ptr->initCommitPolicy(this);
 
 }
 
@@ -385,9 +606,19 @@ QtSliderFactory::QtSliderFactory(QObject *parent)
 */
 QtSliderFactory::~QtSliderFactory()
 {
+    for (QtIntPropertyManager *manager : propertyManagers())
+        manager->removeListener(d_ptr.data());
     qDeleteAll(d_ptr->m_editorToProperty.keys());
 }
 
+/*!
+    \reimp
+*/
+void QtSliderFactory::commitPolicyChanged(const QtProperty *property)
+{
+    d_ptr->applyCommitPolicies(property);
+}
+
 /*!
     \internal
 
@@ -395,8 +626,7 @@ QtSliderFactory::~QtSliderFactory()
 */
 void QtSliderFactory::connectPropertyManager(QtIntPropertyManager *manager)
 {
-    connect(manager, SIGNAL(valueChanged(QtProperty*,int)),
-                this, SLOT(slotPropertyChanged(QtProperty*,int)));
+    manager->addListener(d_ptr.data());
     connect(manager, SIGNAL(rangeChanged(QtProperty*,int,int)),
                 this, SLOT(slotRangeChanged(QtProperty*,int,int)));
     connect(manager, SIGNAL(singleStepChanged(QtProperty*,int)),
@@ -417,6 +647,8 @@ QWidget *QtSliderFactory::createEditor(QtIntPropertyManager *manager, QtProperty
     editor->setRange(manager->minimum(property), manager->maximum(property));
     editor->setValue(manager->value(property));
 
+    d_ptr->applyCommitPolicy(editor, property);
+
     connect(editor, SIGNAL(valueChanged(int)), this, SLOT(slotSetValue(int)));
     connect(editor, SIGNAL(destroyed(QObject*)),
                 this, SLOT(slotEditorDestroyed(QObject*)));
@@ -430,8 +662,7 @@ QWidget *QtSliderFactory::createEditor(QtIntPropertyManager *manager, QtProperty
 */
 void QtSliderFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 {
-    disconnect(manager, SIGNAL(valueChanged(QtProperty*,int)),
-                this, SLOT(slotPropertyChanged(QtProperty*,int)));
+    manager->removeListener(d_ptr.data());
     disconnect(manager, SIGNAL(rangeChanged(QtProperty*,int,int)),
                 this, SLOT(slotRangeChanged(QtProperty*,int,int)));
     disconnect(manager, SIGNAL(singleStepChanged(QtProperty*,int)),
@@ -440,17 +671,26 @@ void QtSliderFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 
 // QtSliderFactory
 
-class QtScrollBarFactoryPrivate : public  EditorFactoryPrivate<QScrollBar>
+class QtScrollBarFactoryPrivate : public EditorFactoryPrivate<QScrollBar>, public QtPropertyChangeListener
 {
     QtScrollBarFactory *q_ptr;
     Q_DECLARE_PUBLIC(QtScrollBarFactory)
 public:
+    void propertyChangeEvent(const QtPropertyChange &change);
     void slotPropertyChanged(QtProperty *property, int value);
     void slotRangeChanged(QtProperty *property, int min, int max);
     void slotSingleStepChanged(QtProperty *property, int step);
     void slotSetValue(int value);
+    void commitValue(QtProperty *property, const QVariant &value);
 };
 
+void QtScrollBarFactoryPrivate::propertyChangeEvent(const QtPropertyChange &change)
+{
+    if (change.type == QtPropertyChange::Destroyed)
+        q_ptr->removeCommitPolicy(change.property);
+    forwardValueChange<QtIntPropertyManager>(this, change);
+}
+
 void QtScrollBarFactoryPrivate::slotPropertyChanged(QtProperty *property, int value)
 {
     const auto it = m_createdEditors.constFind(property);
@@ -500,15 +740,18 @@ void QtScrollBarFactoryPrivate::slotSetValue(int value)
     const QMap<QScrollBar *, QtProperty *>::ConstIterator ecend = m_editorToProperty.constEnd();
     for (QMap<QScrollBar *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != ecend; ++itEditor)
         if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtIntPropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
+            if (!holdCommit(itEditor.key(), value))
+                commitValue(itEditor.value(), value);
             return;
         }
 }
 
+void QtScrollBarFactoryPrivate::commitValue(QtProperty *property, const QVariant &value)
+{
+    if (QtIntPropertyManager *manager = q_ptr->propertyManager(property))
+        manager->setValue(property, value.toInt());
+}
+
 /*!
     \class QtScrollBarFactory
     \internal
@@ -528,6 +771,7 @@ QtScrollBarFactory::QtScrollBarFactory(QObject *parent)
     : QtAbstractEditorFactory<QtIntPropertyManager>(parent), d_ptr(new QtScrollBarFactoryPrivate())
 {
     d_ptr->q_ptr = this;
+    d_ptr->initCommitPolicy(this);
 
 }
 
@@ -536,9 +780,19 @@ QtScrollBarFactory::QtScrollBarFactory(QObject *parent)
 */
 QtScrollBarFactory::~QtScrollBarFactory()
 {
+    for (QtIntPropertyManager *manager : propertyManagers())
+        manager->removeListener(d_ptr.data());
     qDeleteAll(d_ptr->m_editorToProperty.keys());
 }
 
+/*!
+    \reimp
+*/
+void QtScrollBarFactory::commitPolicyChanged(const QtProperty *property)
+{
+    d_ptr->applyCommitPolicies(property);
+}
+
 /*!
     \internal
 
@@ -546,8 +800,7 @@ QtScrollBarFactory::~QtScrollBarFactory()
 */
 void QtScrollBarFactory::connectPropertyManager(QtIntPropertyManager *manager)
 {
-    connect(manager, SIGNAL(valueChanged(QtProperty*,int)),
-                this, SLOT(slotPropertyChanged(QtProperty*,int)));
+    manager->addListener(d_ptr.data());
     connect(manager, SIGNAL(rangeChanged(QtProperty*,int,int)),
                 this, SLOT(slotRangeChanged(QtProperty*,int,int)));
     connect(manager, SIGNAL(singleStepChanged(QtProperty*,int)),
@@ -567,6 +820,8 @@ QWidget *QtScrollBarFactory::createEditor(QtIntPropertyManager *manager, QtPrope
     editor->setSingleStep(manager->singleStep(property));
     editor->setRange(manager->minimum(property), manager->maximum(property));
     editor->setValue(manager->value(property));
+    d_ptr->applyCommitPolicy(editor, property);
+
     connect(editor, SIGNAL(valueChanged(int)), this, SLOT(slotSetValue(int)));
     connect(editor, SIGNAL(destroyed(QObject*)),
                 this, SLOT(slotEditorDestroyed(QObject*)));
@@ -580,8 +835,7 @@ QWidget *QtScrollBarFactory::createEditor(QtIntPropertyManager *manager, QtPrope
 */
 void QtScrollBarFactory::disconnectPropertyManager(QtIntPropertyManager *manager)
 {
-    disconnect(manager, SIGNAL(valueChanged(QtProperty*,int)),
-                this, SLOT(slotPropertyChanged(QtProperty*,int)));
+    manager->removeListener(d_ptr.data());
     disconnect(manager, SIGNAL(rangeChanged(QtProperty*,int,int)),
                 this, SLOT(slotRangeChanged(QtProperty*,int,int)));
     disconnect(manager, SIGNAL(singleStepChanged(QtProperty*,int)),
@@ -590,15 +844,21 @@ void QtScrollBarFactory::disconnectPropertyManager(QtIntPropertyManager *manager
 
 // QtCheckBoxFactory
 
-class QtCheckBoxFactoryPrivate : public EditorFactoryPrivate<QtBoolEdit>
+class QtCheckBoxFactoryPrivate : public EditorFactoryPrivate<QtBoolEdit>, public QtPropertyChangeListener
 {
     QtCheckBoxFactory *q_ptr;
     Q_DECLARE_PUBLIC(QtCheckBoxFactory)
 public:
+    void propertyChangeEvent(const QtPropertyChange &change);
     void slotPropertyChanged(QtProperty *property, bool value);
     void slotSetValue(bool value);
 };
 
+void QtCheckBoxFactoryPrivate::propertyChangeEvent(const QtPropertyChange &change)
+{
+    forwardValueChange<QtBoolPropertyManager>(this, change);
+}
+
 void QtCheckBoxFactoryPrivate::slotPropertyChanged(QtProperty *property, bool value)
 {
     const auto it = m_createdEditors.constFind(property);
@@ -655,6 +915,8 @@ QtCheckBoxFactory::QtCheckBoxFactory(QObject *parent)
 */
 QtCheckBoxFactory::~QtCheckBoxFactory()
 {
+    for (QtBoolPropertyManager *manager : propertyManagers())
+        manager->removeListener(d_ptr.data());
     qDeleteAll(d_ptr->m_editorToProperty.keys());
 }
 
@@ -665,8 +927,7 @@ QtCheckBoxFactory::~QtCheckBoxFactory()
 */
 void QtCheckBoxFactory::connectPropertyManager(QtBoolPropertyManager *manager)
 {
-    connect(manager, SIGNAL(valueChanged(QtProperty*,bool)),
-                this, SLOT(slotPropertyChanged(QtProperty*,bool)));
+    manager->addListener(d_ptr.data());
 }
 
 /*!
@@ -693,25 +954,34 @@ QWidget *QtCheckBoxFactory::createEditor(QtBoolPropertyManager *manager, QtPrope
 */
 void QtCheckBoxFactory::disconnectPropertyManager(QtBoolPropertyManager *manager)
 {
-    disconnect(manager, SIGNAL(valueChanged(QtProperty*,bool)),
-                this, SLOT(slotPropertyChanged(QtProperty*,bool)));
+    manager->removeListener(d_ptr.data());
 }
 
 // QtDoubleSpinBoxFactory
 
-class QtDoubleSpinBoxFactoryPrivate : public EditorFactoryPrivate<QDoubleSpinBox>
+class QtDoubleSpinBoxFactoryPrivate : public EditorFactoryPrivate<QDoubleSpinBox>, public QtPropertyChangeListener
 {
     QtDoubleSpinBoxFactory *q_ptr;
     Q_DECLARE_PUBLIC(QtDoubleSpinBoxFactory)
 public:
+    void propertyChangeEvent(const QtPropertyChange &change);
 
     void slotPropertyChanged(QtProperty *property, double value);
     void slotRangeChanged(QtProperty *property, double min, double max);
     void slotSingleStepChanged(QtProperty *property, double step);
     void slotDecimalsChanged(QtProperty *property, int prec);
     void slotSetValue(double value);
+    void slotEditingFinished();
+    void commitValue(QtProperty *property, const QVariant &value);
 };
 
+void QtDoubleSpinBoxFactoryPrivate::propertyChangeEvent(const QtPropertyChange &change)
+{
+    if (change.type == QtPropertyChange::Destroyed)
+        q_ptr->removeCommitPolicy(change.property);
+    forwardValueChange<QtDoublePropertyManager>(this, change);
+}
+
 void QtDoubleSpinBoxFactoryPrivate::slotPropertyChanged(QtProperty *property, double value)
 {
     const auto it = m_createdEditors.constFind(property);
@@ -786,16 +1056,25 @@ void QtDoubleSpinBoxFactoryPrivate::slotSetValue(double value)
     const QMap<QDoubleSpinBox *, QtProperty *>::ConstIterator itcend = m_editorToProperty.constEnd();
     for (QMap<QDoubleSpinBox *, QtProperty *>::ConstIterator itEditor = m_editorToProperty.constBegin(); itEditor != itcend; ++itEditor) {
         if (itEditor.key() == object) {
-            QtProperty *property = itEditor.value();
-            QtDoublePropertyManager *manager = q_ptr->propertyManager(property);
-            if (!manager)
-                return;
-            manager->setValue(property, value);
+            if (!holdCommit(itEditor.key(), value))
+                commitValue(itEditor.value(), value);
             return;
         }
     }
 }
 
+void QtDoubleSpinBoxFactoryPrivate::slotEditingFinished()
+{
+    if (QDoubleSpinBox *editor = qobject_cast<QDoubleSpinBox *>(q_ptr->sender()))
+        commitHeld(editor);
+}
+
+void QtDoubleSpinBoxFactoryPrivate::commitValue(QtProperty *property, const QVariant &value)
+{
+    if (QtDoublePropertyManager *manager = q_ptr->propertyManager(property))
+        manager->setValue(property, value.toDouble());
+}
+
 /*! \class QtDoubleSpinBoxFactory
     \internal
     \inmodule QtDesigner
@@ -814,6 +1093,7 @@ QtDoubleSpinBoxFactory::QtDoubleSpinBoxFactory(QObject *parent)
     : QtAbstractEditorFactory<QtDoublePropertyManager>(parent), d_ptr(new QtDoubleSpinBoxFactoryPrivate())
 {
     d_ptr->q_ptr = this;
+    d_ptr->initCommitPolicy(this);
 
 }
 
@@ -822,9 +1102,19 @@ QtDoubleSpinBoxFactory::QtDoubleSpinBoxFactory(QObject *parent)
 */
 QtDoubleSpinBoxFactory::~QtDoubleSpinBoxFactory()
 {
+    for (QtDoublePropertyManager *manager : propertyManagers())
+        manager->removeListener(d_ptr.data());
     qDeleteAll(d_ptr->m_editorToProperty.keys());
 }
 
+/*!
+    \reimp
+*/
+void QtDoubleSpinBoxFactory::commitPolicyChanged(const QtProperty *property)
+{
+    d_ptr->applyCommitPolicies(property);
+}
+
 /*!
     \internal
 
@@ -832,8 +1122,7 @@ QtDoubleSpinBoxFactory::~QtDoubleSpinBoxFactory()
 */
 void QtDoubleSpinBoxFactory::connectPropertyManager(QtDoublePropertyManager *manager)
 {
-    connect(manager, SIGNAL(valueChanged(QtProperty*,double)),
-                this, SLOT(slotPropertyChanged(QtProperty*,double)));
+    manager->addListener(d_ptr.data());
     connect(manager, SIGNAL(rangeChanged(QtProperty*,double,double)),
                 this, SLOT(slotRangeChanged(QtProperty*,double,double)));
     connect(manager, SIGNAL(singleStepChanged(QtProperty*,double)),
@@ -857,7 +1146,10 @@ QWidget *QtDoubleSpinBoxFactory::createEditor(QtDoublePropertyManager *manager,
     editor->setValue(manager->value(property));
     editor->setKeyboardTracking(false);
 
+    d_ptr->applyCommitPolicy(editor, property);
+
     connect(editor, SIGNAL(valueChanged(double)), this, SLOT(slotSetValue(double)));
+    connect(editor, SIGNAL(editingFinished()), this, SLOT(slotEditingFinished()));
     connect(editor, SIGNAL(destroyed(QObject*)),
                 this, SLOT(slotEditorDestroyed(QObject*)));
     return editor;
@@ -870,8 +1162,7 @@ QWidget *QtDoubleSpinBoxFactory::createEditor(QtDoublePropertyManager *manager,
 */
 void QtDoubleSpinBoxFactory::disconnectPropertyManager(QtDoublePropertyManager *manager)
 {
-    disconnect(manager, SIGNAL(valueChanged(QtProperty*,double)),
-                this, SLOT(slotPropertyChanged(QtProperty*,double)));
+    manager->removeListener(d_ptr.data());
     disconnect(manager, SIGNAL(rangeChanged(QtProperty*,double,double)),
                 this, SLOT(slotRangeChanged(QtProperty*,double,double)));
     disconnect(manager, SIGNAL(singleStepChanged(QtProperty*,double)),
@@ -888,11 +1179,43 @@ class QtLineEditFactoryPrivate : public EditorFactoryPrivate<QLineEdit>
     Q_DECLARE_PUBLIC(QtLineEditFactory)
 public:
 
+    QRegularExpressionValidator *acquireValidator(const QRegularExpression &regularExpression);
+    void releaseValidator(QRegularExpressionValidator *validator);
+
     void slotPropertyChanged(QtProperty *property, const QString &value);
-    void slotRegExpChanged(QtProperty *property, const QRegExp &regExp);
+    void slotRegularExpressionChanged(QtProperty *property, const QRegularExpression &regularExpression);
     void slotSetValue(const QString &value);
+    void slotEditorDestroyed(QObject *object);
+
+    // validators are shared by all editors whose properties use the same expression
+    QHash<QRegularExpression, QRegularExpressionValidator *> m_validators;
+    QHash<QRegularExpressionValidator *, int> m_validatorRefs;
+    QMap<QtProperty *, QRegularExpressionValidator *> m_propertyToValidator;
 };
 
+QRegularExpressionValidator *QtLineEditFactoryPrivate::acquireValidator(const QRegularExpression &regularExpression)
+{
+    if (regularExpression.pattern().isEmpty() || !regularExpression.isValid())
+        return 0;
+
+    QRegularExpressionValidator *validator = m_validators.value(regularExpression, 0);
+    if (!validator) {
+        validator = new QRegularExpressionValidator(regularExpression);
+        m_validators.insert(regularExpression, validator);
+    }
+    ++m_validatorRefs[validator];
+    return validator;
+}
+
+void QtLineEditFactoryPrivate::releaseValidator(QRegularExpressionValidator *validator)
+{
+    if (--m_validatorRefs[validator] > 0)
+        return;
+    m_validatorRefs.remove(validator);
+    m_validators.remove(validator->regularExpression());
+    delete validator;
+}
+
 void QtLineEditFactoryPrivate::slotPropertyChanged(QtProperty *property,
                 const QString &value)
 {
@@ -906,29 +1229,39 @@ void QtLineEditFactoryPrivate::slotPropertyChanged(QtProperty *property,
     }
 }
 
-void QtLineEditFactoryPrivate::slotRegExpChanged(QtProperty *property,
-            const QRegExp &regExp)
+void QtLineEditFactoryPrivate::slotRegularExpressionChanged(QtProperty *property,
+            const QRegularExpression &regularExpression)
 {
     const auto it = m_createdEditors.constFind(property);
     if (it == m_createdEditors.constEnd())
         return;
 
-    QtStringPropertyManager *manager = q_ptr->propertyManager(property);
-    if (!manager)
-        return;
+    QRegularExpressionValidator *oldValidator = m_propertyToValidator.take(property);
+    QRegularExpressionValidator *validator = acquireValidator(regularExpression);
+    if (validator)
+        m_propertyToValidator.insert(property, validator);
 
     for (QLineEdit *editor : it.value()) {
         editor->blockSignals(true);
-        const QValidator *oldValidator = editor->validator();
-        QValidator *newValidator = 0;
-        if (regExp.isValid()) {
-            newValidator = new QRegExpValidator(regExp, editor);
-        }
-        editor->setValidator(newValidator);
-        if (oldValidator)
-            delete oldValidator;
+        editor->setValidator(validator);
         editor->blockSignals(false);
     }
+
+    if (oldValidator)
+        releaseValidator(oldValidator);
+}
+
+void QtLineEditFactoryPrivate::slotEditorDestroyed(QObject *object)
+{
+    QtProperty *property = m_editorToProperty.value(static_cast<QLineEdit *>(object), 0);
+    EditorFactoryPrivate<QLineEdit>::slotEditorDestroyed(object);
+    if (!property || m_createdEditors.contains(property))
+        return;
+
+    // the last editor of the property is gone, drop its validator reference
+    QRegularExpressionValidator *validator = m_propertyToValidator.take(property);
+    if (validator)
+        releaseValidator(validator);
 }
 
 void QtLineEditFactoryPrivate::slotSetValue(const QString &value)
@@ -974,6 +1307,7 @@ QtLineEditFactory::QtLineEditFactory(QObject *parent)
 QtLineEditFactory::~QtLineEditFactory()
 {
     qDeleteAll(d_ptr->m_editorToProperty.keys());
+    qDeleteAll(d_ptr->m_validatorRefs.keys());
 }
 
 /*!
@@ -985,8 +1319,8 @@ void QtLineEditFactory::connectPropertyManager(QtStringPropertyManager *manager)
 {
     connect(manager, SIGNAL(valueChanged(QtProperty*,QString)),
                 this, SLOT(slotPropertyChanged(QtProperty*,QString)));
-    connect(manager, SIGNAL(regExpChanged(QtProperty*,QRegExp)),
-                this, SLOT(slotRegExpChanged(QtProperty*,QRegExp)));
+    connect(manager, SIGNAL(regularExpressionChanged(QtProperty*,QRegularExpression)),
+                this, SLOT(slotRegularExpressionChanged(QtProperty*,QRegularExpression)));
 }
 
 /*!
@@ -999,11 +1333,13 @@ QWidget *QtLineEditFactory::createEditor(QtStringPropertyManager *manager,
 {
 
     QLineEdit *editor = d_ptr->createEditor(property, parent);
-    QRegExp regExp = manager->regExp(property);
-    if (regExp.isValid()) {
-        QValidator *validator = new QRegExpValidator(regExp, editor);
-        editor->setValidator(validator);
+    QRegularExpressionValidator *validator = d_ptr->m_propertyToValidator.value(property, 0);
+    if (!validator) {
+        validator = d_ptr->acquireValidator(manager->regularExpression(property));
+        if (validator)
+            d_ptr->m_propertyToValidator.insert(property, validator);
     }
+    editor->setValidator(validator);
     editor->setText(manager->value(property));
 
     connect(editor, SIGNAL(textEdited(QString)),
@@ -1022,8 +1358,8 @@ void QtLineEditFactory::disconnectPropertyManager(QtStringPropertyManager *manag
 {
     disconnect(manager, SIGNAL(valueChanged(QtProperty*,QString)),
                 this, SLOT(slotPropertyChanged(QtProperty*,QString)));
-    disconnect(manager, SIGNAL(regExpChanged(QtProperty*,QRegExp)),
-                this, SLOT(slotRegExpChanged(QtProperty*,QRegExp)));
+    disconnect(manager, SIGNAL(regularExpressionChanged(QtProperty*,QRegularExpression)),
+                this, SLOT(slotRegularExpressionChanged(QtProperty*,QRegularExpression)));
 }
 
 // QtDateEditFactory
@@ -1777,33 +2113,123 @@ void QtCharEditorFactory::disconnectPropertyManager(QtCharPropertyManager *manag
 
 // QtEnumEditorFactory
 
+// Item model holding one distinct list of enum names and icons. All combo
+// boxes editing enum properties with equal names and icons share one model,
+// so opening an editor does not rebuild the combo items.
+
+class QtEnumListModel : public QAbstractListModel
+{
+public:
+    QtEnumListModel(const QStringList &names, const QMap<int, QIcon> &icons)
+        : m_names(names), m_icons(icons), m_ref(0) {}
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+
+    bool matches(const QStringList &names, const QMap<int, QIcon> &icons) const;
+    static uint contentsKey(const QStringList &names);
+
+    const QStringList m_names;
+    const QMap<int, QIcon> m_icons;
+    int m_ref;
+};
+
+int QtEnumListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_names.count();
+}
+
+QVariant QtEnumListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_names.count())
+        return QVariant();
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return m_names.at(index.row());
+    case Qt::DecorationRole: {
+        const auto it = m_icons.constFind(index.row());
+        if (it != m_icons.constEnd())
+            return it.value();
+        break;
+    }
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+bool QtEnumListModel::matches(const QStringList &names, const QMap<int, QIcon> &icons) const
+{
+    // Lists handed out by the same manager share their data, which makes
+    // this comparison cheap for the common case.
+    if (m_names != names || m_icons.count() != icons.count())
+        return false;
+
+    auto it = m_icons.constBegin();
+    auto other = icons.constBegin();
+    for ( ; it != m_icons.constEnd(); ++it, ++other) {
+        if (it.key() != other.key() || it.value().cacheKey() != other.value().cacheKey())
+            return false;
+    }
+    return true;
+}
+
+// Cheap key that does not walk the whole list; collisions are resolved by matches().
+uint QtEnumListModel::contentsKey(const QStringList &names)
+{
+    if (names.isEmpty())
+        return 0;
+    return qHash(names.count()) ^ qHash(names.first()) ^ (qHash(names.last()) << 1);
+}
+
 class QtEnumEditorFactoryPrivate : public EditorFactoryPrivate<QComboBox>
 {
     QtEnumEditorFactory *q_ptr;
     Q_DECLARE_PUBLIC(QtEnumEditorFactory)
 public:
 
+    QtEnumListModel *acquireModel(const QStringList &enumNames, const QMap<int, QIcon> &enumIcons);
+    void releaseModel(QtEnumListModel *model);
+    void rebindModel(QtProperty *property, const QStringList &enumNames, const QMap<int, QIcon> &enumIcons);
+
     void slotPropertyChanged(QtProperty *property, int value);
     void slotEnumNamesChanged(QtProperty *property, const QStringList &);
     void slotEnumIconsChanged(QtProperty *property, const QMap<int, QIcon> &);
     void slotSetValue(int value);
+    void slotEditorDestroyed(QObject *object);
+
+    QMultiHash<uint, QtEnumListModel *> m_models;
+    QMap<QtProperty *, QtEnumListModel *> m_propertyToModel;
 };
 
-void QtEnumEditorFactoryPrivate::slotPropertyChanged(QtProperty *property, int value)
+QtEnumListModel *QtEnumEditorFactoryPrivate::acquireModel(const QStringList &enumNames,
+                const QMap<int, QIcon> &enumIcons)
 {
-    const auto it = m_createdEditors.constFind(property);
-    if (it == m_createdEditors.constEnd())
-        return;
-
-    for (QComboBox *editor : it.value()) {
-        editor->blockSignals(true);
-        editor->setCurrentIndex(value);
-        editor->blockSignals(false);
+    const uint key = QtEnumListModel::contentsKey(enumNames);
+    for (auto it = m_models.find(key); it != m_models.end() && it.key() == key; ++it) {
+        if (it.value()->matches(enumNames, enumIcons)) {
+            ++it.value()->m_ref;
+            return it.value();
+        }
     }
+    QtEnumListModel *model = new QtEnumListModel(enumNames, enumIcons);
+    model->m_ref = 1;
+    m_models.insert(key, model);
+    return model;
 }
 
-void QtEnumEditorFactoryPrivate::slotEnumNamesChanged(QtProperty *property,
-                const QStringList &enumNames)
+void QtEnumEditorFactoryPrivate::releaseModel(QtEnumListModel *model)
+{
+    if (--model->m_ref > 0)
+        return;
+    m_models.remove(QtEnumListModel::contentsKey(model->m_names), model);
+    delete model;
+}
+
+void QtEnumEditorFactoryPrivate::rebindModel(QtProperty *property,
+                const QStringList &enumNames, const QMap<int, QIcon> &enumIcons)
 {
     const auto it = m_createdEditors.constFind(property);
     if (it == m_createdEditors.constEnd())
@@ -1813,42 +2239,68 @@ void QtEnumEditorFactoryPrivate::slotEnumNamesChanged(QtProperty *property,
     if (!manager)
         return;
 
-    QMap<int, QIcon> enumIcons = manager->enumIcons(property);
+    QtEnumListModel *oldModel = m_propertyToModel.value(property, 0);
+    QtEnumListModel *model = acquireModel(enumNames, enumIcons);
+    m_propertyToModel[property] = model;
 
     for (QComboBox *editor : it.value()) {
         editor->blockSignals(true);
-        editor->clear();
-        editor->addItems(enumNames);
-        const int nameCount = enumNames.count();
-        for (int i = 0; i < nameCount; i++)
-            editor->setItemIcon(i, enumIcons.value(i));
+        if (editor->model() != model)
+            editor->setModel(model);
         editor->setCurrentIndex(manager->value(property));
         editor->blockSignals(false);
     }
+
+    if (oldModel)
+        releaseModel(oldModel);
 }
 
-void QtEnumEditorFactoryPrivate::slotEnumIconsChanged(QtProperty *property,
-                const QMap<int, QIcon> &enumIcons)
+void QtEnumEditorFactoryPrivate::slotPropertyChanged(QtProperty *property, int value)
 {
     const auto it = m_createdEditors.constFind(property);
     if (it == m_createdEditors.constEnd())
         return;
 
-    QtEnumPropertyManager *manager = q_ptr->propertyManager(property);
-    if (!manager)
-        return;
-
-    const QStringList enumNames = manager->enumNames(property);
     for (QComboBox *editor : it.value()) {
         editor->blockSignals(true);
-        const int nameCount = enumNames.count();
-        for (int i = 0; i < nameCount; i++)
-            editor->setItemIcon(i, enumIcons.value(i));
-        editor->setCurrentIndex(manager->value(property));
+        editor->setCurrentIndex(value);
         editor->blockSignals(false);
     }
 }
 
+void QtEnumEditorFactoryPrivate::slotEnumNamesChanged(QtProperty *property,
+                const QStringList &enumNames)
+{
+    QtEnumPropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+
+    rebindModel(property, enumNames, manager->enumIcons(property));
+}
+
+void QtEnumEditorFactoryPrivate::slotEnumIconsChanged(QtProperty *property,
+                const QMap<int, QIcon> &enumIcons)
+{
+    QtEnumPropertyManager *manager = q_ptr->propertyManager(property);
+    if (!manager)
+        return;
+
+    rebindModel(property, manager->enumNames(property), enumIcons);
+}
+
+void QtEnumEditorFactoryPrivate::slotEditorDestroyed(QObject *object)
+{
+    QtProperty *property = m_editorToProperty.value(static_cast<QComboBox *>(object), 0);
+    EditorFactoryPrivate<QComboBox>::slotEditorDestroyed(object);
+    if (!property || m_createdEditors.contains(property))
+        return;
+
+    // the last editor of the property is gone, drop its model reference
+    QtEnumListModel *model = m_propertyToModel.take(property);
+    if (model)
+        releaseModel(model);
+}
+
 void QtEnumEditorFactoryPrivate::slotSetValue(int value)
 {
     QObject *object = q_ptr->sender();
@@ -1905,6 +2357,8 @@ void QtEnumEditorFactory::connectPropertyManager(QtEnumPropertyManager *manager)
                 this, SLOT(slotPropertyChanged(QtProperty*,int)));
     connect(manager, SIGNAL(enumNamesChanged(QtProperty*,QStringList)),
                 this, SLOT(slotEnumNamesChanged(QtProperty*,QStringList)));
+    connect(manager, SIGNAL(enumIconsChanged(QtProperty*,QMap<int,QIcon>)),
+                this, SLOT(slotEnumIconsChanged(QtProperty*,QMap<int,QIcon>)));
 }
 
 /*!
@@ -1918,12 +2372,12 @@ QWidget *QtEnumEditorFactory::createEditor(QtEnumPropertyManager *manager, QtPro
     QComboBox *editor = d_ptr->createEditor(property, parent);
     editor->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Fixed);
     editor->view()->setTextElideMode(Qt::ElideRight);
-    QStringList enumNames = manager->enumNames(property);
-    editor->addItems(enumNames);
-    QMap<int, QIcon> enumIcons = manager->enumIcons(property);
-    const int enumNamesCount = enumNames.count();
-    for (int i = 0; i < enumNamesCount; i++)
-        editor->setItemIcon(i, enumIcons.value(i));
+    QtEnumListModel *model = d_ptr->m_propertyToModel.value(property, 0);
+    if (!model) {
+        model = d_ptr->acquireModel(manager->enumNames(property), manager->enumIcons(property));
+        d_ptr->m_propertyToModel.insert(property, model);
+    }
+    editor->setModel(model);
     editor->setCurrentIndex(manager->value(property));
 
     connect(editor, SIGNAL(currentIndexChanged(int)), this, SLOT(slotSetValue(int)));
@@ -1943,6 +2397,8 @@ void QtEnumEditorFactory::disconnectPropertyManager(QtEnumPropertyManager *manag
                 this, SLOT(slotPropertyChanged(QtProperty*,int)));
     disconnect(manager, SIGNAL(enumNamesChanged(QtProperty*,QStringList)),
                 this, SLOT(slotEnumNamesChanged(QtProperty*,QStringList)));
+    disconnect(manager, SIGNAL(enumIconsChanged(QtProperty*,QMap<int,QIcon>)),
+                this, SLOT(slotEnumIconsChanged(QtProperty*,QMap<int,QIcon>)));
 }
 
 // QtCursorEditorFactory
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qtgroupboxpropertybrowser.h"
+#include "qtpropertybrowserutils_p.h"
 #include <QtCore/QSet>
 #include <QtWidgets/QGridLayout>
 #include <QtWidgets/QLabel>
@@ -52,14 +53,18 @@ class QtGroupBoxPropertyBrowserPrivate
     QtGroupBoxPropertyBrowser *q_ptr;
     Q_DECLARE_PUBLIC(QtGroupBoxPropertyBrowser)
 public:
+    QtGroupBoxPropertyBrowserPrivate() : m_mainLayout(0), m_rowView(0) {}
 
     void init(QWidget *parent);
+    void setWidgetFree(bool widgetFree);
 
     void propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex);
     void propertyRemoved(QtBrowserItem *index);
     void propertyChanged(QtBrowserItem *index);
     QWidget *createEditor(QtProperty *property, QWidget *parent) const
         { return q_ptr->createEditor(property, parent); }
+    bool hasEditorFactory(QtProperty *property) const
+        { return q_ptr->hasEditorFactory(property); }
 
     void slotEditorDestroyed();
     void slotUpdate();
@@ -82,6 +87,8 @@ private:
     void removeRow(QGridLayout *layout, int row) const;
 
     bool hasHeader(WidgetItem *item) const;
+    void insertItems(QtBrowserItem *index, QtBrowserItem *afterIndex);
+    void removeItems(QtBrowserItem *index);
 
     QMap<QtBrowserItem *, WidgetItem *> m_indexToItem;
     QMap<WidgetItem *, QtBrowserItem *> m_itemToIndex;
@@ -89,6 +96,23 @@ private:
     QGridLayout *m_mainLayout;
     QList<WidgetItem *> m_children;
     QList<WidgetItem *> m_recreateQueue;
+    QtPropertyRowView *m_rowView; // set in widget-free mode
+};
+
+class QtGroupBoxRowView : public QtPropertyRowView
+{
+public:
+    QtGroupBoxRowView(QtGroupBoxPropertyBrowserPrivate *browserPrivate, QtGroupBoxPropertyBrowser *browser)
+        : QtPropertyRowView(browser, GroupBoxGroups, browser), m_browserPrivate(browserPrivate) {}
+
+protected:
+    QWidget *createEditor(QtProperty *property, QWidget *parent)
+        { return m_browserPrivate->createEditor(property, parent); }
+    bool isEditable(QtProperty *property) const
+        { return m_browserPrivate->hasEditorFactory(property); }
+
+private:
+    QtGroupBoxPropertyBrowserPrivate *m_browserPrivate;
 };
 
 void QtGroupBoxPropertyBrowserPrivate::init(QWidget *parent)
@@ -100,6 +124,53 @@ void QtGroupBoxPropertyBrowserPrivate::init(QWidget *parent)
     m_mainLayout->addItem(item, 0, 0);
 }
 
+void QtGroupBoxPropertyBrowserPrivate::setWidgetFree(bool widgetFree)
+{
+    if (widgetFree == (m_rowView != 0))
+        return;
+
+    // take all items down and rebuild them in the other mode
+    const QList<QtBrowserItem *> items = q_ptr->topLevelItems();
+    for (auto it = items.crbegin(), rend = items.crend(); it != rend; ++it)
+        removeItems(*it);
+
+    if (widgetFree) {
+        m_rowView = new QtGroupBoxRowView(this, q_ptr);
+        insertRow(m_mainLayout, 0);
+        m_mainLayout->addWidget(m_rowView, 0, 0, 1, 2);
+    } else {
+        m_mainLayout->removeWidget(m_rowView);
+        delete m_rowView;
+        m_rowView = 0;
+        removeRow(m_mainLayout, 0);
+    }
+
+    QtBrowserItem *afterItem = 0;
+    for (QtBrowserItem *item : items) {
+        insertItems(item, afterItem);
+        afterItem = item;
+    }
+}
+
+void QtGroupBoxPropertyBrowserPrivate::insertItems(QtBrowserItem *index, QtBrowserItem *afterIndex)
+{
+    propertyInserted(index, afterIndex);
+    QtBrowserItem *afterChild = 0;
+    const auto children = index->children();
+    for (QtBrowserItem *child : children) {
+        insertItems(child, afterChild);
+        afterChild = child;
+    }
+}
+
+void QtGroupBoxPropertyBrowserPrivate::removeItems(QtBrowserItem *index)
+{
+    const auto children = index->children();
+    for (int i = children.count(); i > 0; i--)
+        removeItems(children.at(i - 1));
+    propertyRemoved(index);
+}
+
 void QtGroupBoxPropertyBrowserPrivate::slotEditorDestroyed()
 {
     QWidget *editor = qobject_cast<QWidget *>(q_ptr->sender());
@@ -160,6 +231,11 @@ void QtGroupBoxPropertyBrowserPrivate::updateLater()
 
 void QtGroupBoxPropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, QtBrowserItem *afterIndex)
 {
+    if (m_rowView) {
+        m_rowView->itemInserted(index);
+        return;
+    }
+
     WidgetItem *afterItem = m_indexToItem.value(afterIndex);
     WidgetItem *parentItem = m_indexToItem.value(index->parent());
 
@@ -266,6 +342,11 @@ void QtGroupBoxPropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, Qt
 
 void QtGroupBoxPropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
 {
+    if (m_rowView) {
+        m_rowView->itemRemoved(index);
+        return;
+    }
+
     WidgetItem *item = m_indexToItem.value(index);
 
     m_indexToItem.remove(index);
@@ -386,6 +467,11 @@ bool QtGroupBoxPropertyBrowserPrivate::hasHeader(WidgetItem *item) const
 
 void QtGroupBoxPropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
 {
+    if (m_rowView) {
+        m_rowView->itemChanged(index);
+        return;
+    }
+
     WidgetItem *item = m_indexToItem.value(index);
 
     updateItem(item);
@@ -463,6 +549,27 @@ void QtGroupBoxPropertyBrowserPrivate::updateItem(WidgetItem *item)
     \sa QtTreePropertyBrowser, QtAbstractPropertyBrowser
 */
 
+/*!
+    \property QtGroupBoxPropertyBrowser::widgetFree
+    \brief whether the rows are painted instead of being built from widgets.
+
+    By default every property gets a label, a value label or editor,
+    and every property with subproperties a group box, all held in
+    nested grid layouts. In widget-free mode the rows and group boxes
+    are painted with the current style instead, and only the row the
+    user clicks gets a real editor, so the cost of a browser depends on
+    the rows on screen rather than on the number of properties.
+*/
+bool QtGroupBoxPropertyBrowser::isWidgetFree() const
+{
+    return d_ptr->m_rowView != 0;
+}
+
+void QtGroupBoxPropertyBrowser::setWidgetFree(bool widgetFree)
+{
+    d_ptr->setWidgetFree(widgetFree);
+}
+
 /*!
     Creates a property browser with the given \a parent.
 */
@@ -49,11 +49,15 @@ class QtGroupBoxPropertyBrowserPrivate;
 class QtGroupBoxPropertyBrowser : public QtAbstractPropertyBrowser
 {
     Q_OBJECT
+    Q_PROPERTY(bool widgetFree READ isWidgetFree WRITE setWidgetFree)
 public:
 
     QtGroupBoxPropertyBrowser(QWidget *parent = 0);
     ~QtGroupBoxPropertyBrowser();
 
+    bool isWidgetFree() const;
+    void setWidgetFree(bool widgetFree);
+
 protected:
     virtual void itemInserted(QtBrowserItem *item, QtBrowserItem *afterItem);
     virtual void itemRemoved(QtBrowserItem *item);
@@ -0,0 +1,678 @@
+/****************************************************************************
+**
+** Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+** All rights reserved.
+**
+** Contact: Nokia Corporation (qt-info@nokia.com)
+**
+** This file is part of a Qt Solutions component.
+**
+** You may use this file under the terms of the BSD license as follows:
+**
+** "Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are
+** met:
+**   * Redistributions of source code must retain the above copyright
+**     notice, this list of conditions and the following disclaimer.
+**   * Redistributions in binary form must reproduce the above copyright
+**     notice, this list of conditions and the following disclaimer in
+**     the documentation and/or other materials provided with the
+**     distribution.
+**   * Neither the name of Nokia Corporation and its Subsidiary(-ies) nor
+**     the names of its contributors may be used to endorse or promote
+**     products derived from this software without specific prior written
+**     permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+** "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+** LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+** A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+** OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+** SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+** LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+** OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE."
+**
+****************************************************************************/
+
+#include "qtobjectcontroller.h"
+#include "qtvariantproperty.h"
+#include "qttreepropertybrowser.h"
+#include <QtCore/QHash>
+#include <QtCore/QMetaObject>
+#include <QtCore/QMetaProperty>
+#include <QtCore/QMutex>
+#include <QtCore/QtAlgorithms>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+#include <QtWidgets/QVBoxLayout>
+
+QT_BEGIN_NAMESPACE
+
+static bool isPowerOf2(int value)
+{
+    const uint bits = uint(value);
+    return bits && !(bits & (bits - 1));
+}
+
+// Maps between the values of a QMetaEnum and the indexes used by the
+// enum and flag properties. Keys with the same value are shown once, and
+// flag properties only show the single bit values.
+class QtMetaEnumTable
+{
+public:
+    explicit QtMetaEnumTable(const QMetaEnum &metaEnum);
+
+    bool isFlag() const { return m_flag; }
+    QStringList names() const { return m_names; }
+
+    int toIndex(int value) const;
+    int fromIndex(int index) const;
+
+private:
+    bool m_flag;
+    QStringList m_names;
+    QVector<int> m_values;
+    QHash<int, int> m_valueToIndex;
+    int m_bitToIndex[32];
+};
+
+QtMetaEnumTable::QtMetaEnumTable(const QMetaEnum &metaEnum)
+    : m_flag(metaEnum.isFlag())
+{
+    for (int bit = 0; bit < 32; bit++)
+        m_bitToIndex[bit] = -1;
+
+    for (int i = 0; i < metaEnum.keyCount(); i++) {
+        const int value = metaEnum.value(i);
+        if (m_valueToIndex.contains(value))
+            continue;
+        if (m_flag) {
+            if (!isPowerOf2(value))
+                continue;
+            m_bitToIndex[qCountTrailingZeroBits(uint(value))] = m_values.count();
+        }
+        m_valueToIndex.insert(value, m_values.count());
+        m_values.append(value);
+        m_names.append(QLatin1String(metaEnum.key(i)));
+    }
+}
+
+int QtMetaEnumTable::toIndex(int value) const
+{
+    if (!m_flag)
+        return m_valueToIndex.value(value, -1);
+
+    int index = 0;
+    uint bits = uint(value);
+    while (bits) {
+        const int position = m_bitToIndex[qCountTrailingZeroBits(bits)];
+        if (position >= 0)
+            index |= 1 << position;
+        bits &= bits - 1;
+    }
+    return index;
+}
+
+int QtMetaEnumTable::fromIndex(int index) const
+{
+    if (!m_flag)
+        return index >= 0 && index < m_values.count() ? m_values.at(index) : -1;
+
+    int value = 0;
+    uint bits = uint(index);
+    while (bits) {
+        const int position = qCountTrailingZeroBits(bits);
+        if (position >= m_values.count())
+            return -1;
+        value |= m_values.at(position);
+        bits &= bits - 1;
+    }
+    return value;
+}
+
+// The reflected description of one QMetaProperty, with the thunks that
+// convert between the object's value and the property's value.
+struct QtMetaPropertyInfo
+{
+    enum Kind
+    {
+        NonReadable,
+        Enum,
+        Value
+    };
+
+    Kind kind;
+    QMetaProperty metaProperty;
+    const QMetaObject *metaObject;
+    int type;
+    QSharedPointer<QtMetaEnumTable> enumTable;
+    QVariant (*read)(const QtMetaPropertyInfo &info, const QObject *object);
+    void (*write)(const QtMetaPropertyInfo &info, QObject *object, const QVariant &value);
+};
+
+static QVariant readValue(const QtMetaPropertyInfo &info, const QObject *object)
+{
+    return info.metaProperty.read(object);
+}
+
+static void writeValue(const QtMetaPropertyInfo &info, QObject *object, const QVariant &value)
+{
+    info.metaProperty.write(object, value);
+}
+
+static QVariant readEnum(const QtMetaPropertyInfo &info, const QObject *object)
+{
+    return info.enumTable->toIndex(info.metaProperty.read(object).toInt());
+}
+
+static void writeEnum(const QtMetaPropertyInfo &info, QObject *object, const QVariant &value)
+{
+    info.metaProperty.write(object, info.enumTable->fromIndex(value.toInt()));
+}
+
+// The reflected properties a class adds to its superclass, and the
+// class hierarchy from QObject down to the class itself.
+class QtMetaClassSchema
+{
+public:
+    explicit QtMetaClassSchema(const QMetaObject *metaObject);
+
+    QVector<const QMetaObject *> classes;
+    QVector<QtMetaPropertyInfo> properties;
+};
+
+QtMetaClassSchema::QtMetaClassSchema(const QMetaObject *metaObject)
+{
+    for (const QMetaObject *cls = metaObject; cls; cls = cls->superClass())
+        classes.prepend(cls);
+
+    const int count = metaObject->propertyCount() - metaObject->propertyOffset();
+    properties.reserve(count);
+    for (int idx = metaObject->propertyOffset(); idx < metaObject->propertyCount(); idx++) {
+        QtMetaPropertyInfo info;
+        info.metaProperty = metaObject->property(idx);
+        info.metaObject = metaObject;
+        info.type = info.metaProperty.userType();
+        info.read = 0;
+        info.write = 0;
+        if (!info.metaProperty.isReadable()) {
+            info.kind = QtMetaPropertyInfo::NonReadable;
+        } else if (info.metaProperty.isEnumType()) {
+            info.kind = QtMetaPropertyInfo::Enum;
+            info.enumTable = QSharedPointer<QtMetaEnumTable>(new QtMetaEnumTable(info.metaProperty.enumerator()));
+            info.type = info.enumTable->isFlag() ? QtVariantPropertyManager::flagTypeId()
+                                                 : QtVariantPropertyManager::enumTypeId();
+            info.read = readEnum;
+            info.write = writeEnum;
+        } else {
+            info.kind = QtMetaPropertyInfo::Value;
+            info.read = readValue;
+            info.write = writeValue;
+        }
+        properties.append(info);
+    }
+}
+
+// Schemas are immutable once built and live as long as the application,
+// so the pointers handed out stay valid without further locking.
+class QtMetaClassSchemaCache
+{
+public:
+    ~QtMetaClassSchemaCache();
+
+    const QtMetaClassSchema *schema(const QMetaObject *metaObject);
+
+private:
+    QMutex m_mutex;
+    QHash<const QMetaObject *, QtMetaClassSchema *> m_schemas;
+};
+
+Q_GLOBAL_STATIC(QtMetaClassSchemaCache, metaClassSchemaCache)
+
+QtMetaClassSchemaCache::~QtMetaClassSchemaCache()
+{
+    qDeleteAll(m_schemas);
+}
+
+const QtMetaClassSchema *QtMetaClassSchemaCache::schema(const QMetaObject *metaObject)
+{
+    QMutexLocker locker(&m_mutex);
+    QtMetaClassSchema *&schema = m_schemas[metaObject];
+    if (!schema)
+        schema = new QtMetaClassSchema(metaObject);
+    return schema;
+}
+
+static const QtMetaClassSchema *metaClassSchema(const QMetaObject *metaObject)
+{
+    if (QtMetaClassSchemaCache *cache = metaClassSchemaCache())
+        return cache->schema(metaObject);
+    return 0;
+}
+
+class QtObjectControllerPrivate : public QtVariantValueSource
+{
+    QtObjectController *q_ptr;
+    Q_DECLARE_PUBLIC(QtObjectController)
+public:
+    QtObjectControllerPrivate();
+
+    QVariant value(const QtProperty *property) const;
+    void setValue(QtProperty *property, const QVariant &value);
+    uint version(const QtProperty *property) const;
+
+    QtProperty *classProperty(const QMetaObject *metaObject);
+    void updateValues();
+    void connectObject();
+    void disconnectObject();
+    void invalidatePolledProperties();
+    void scheduleUpdate();
+    void updatePollTimer();
+    void saveExpandedState();
+    void restoreExpandedState();
+    void slotValueChanged(QtProperty *property, const QVariant &value);
+    void slotPropertyNotified();
+    void slotObjectDestroyed();
+    void slotUpdateValues();
+    void slotPoll();
+
+    QObject *m_object;
+    uint m_version;
+    QHash<const QtProperty *, uint> m_propertyToVersion;
+
+    QHash<int, QList<QtProperty *> > m_signalToProperties;
+    QList<QtProperty *> m_polledProperties;
+    QTimer *m_updateTimer;
+    QTimer *m_pollTimer;
+    int m_pollInterval;
+
+    QHash<const QMetaObject *, QtProperty *> m_classToProperty;
+    QHash<const QtProperty *, const QMetaObject *> m_propertyToClass;
+    QHash<const QtProperty *, const QtMetaPropertyInfo *> m_propertyToInfo;
+    QHash<const QtMetaPropertyInfo *, QtProperty *> m_infoToProperty;
+
+    QByteArray m_browserState;
+
+    QList<QtProperty *> m_topLevelProperties;
+
+    QtAbstractPropertyBrowser *m_browser;
+    QtVariantPropertyManager *m_manager;
+    QtVariantPropertyManager *m_readOnlyManager;
+};
+
+QtObjectControllerPrivate::QtObjectControllerPrivate() :
+    m_object(0),
+    m_version(0),
+    m_updateTimer(0),
+    m_pollTimer(0),
+    m_pollInterval(0),
+    m_browser(0),
+    m_manager(0),
+    m_readOnlyManager(0)
+{
+}
+
+QVariant QtObjectControllerPrivate::value(const QtProperty *property) const
+{
+    const QtMetaPropertyInfo *info = m_propertyToInfo.value(property, 0);
+    if (!m_object || !info || !info->read)
+        return QVariant();
+
+    // cached classes the current object does not inherit are never read
+    if (!m_object->metaObject()->inherits(info->metaObject))
+        return QVariant();
+
+    return info->read(*info, m_object);
+}
+
+void QtObjectControllerPrivate::setValue(QtProperty *property, const QVariant &value)
+{
+    const QtMetaPropertyInfo *info = m_propertyToInfo.value(property, 0);
+    if (!m_object || !info || !info->write)
+        return;
+
+    if (!m_object->metaObject()->inherits(info->metaObject))
+        return;
+
+    info->write(*info, m_object, value);
+}
+
+uint QtObjectControllerPrivate::version(const QtProperty *property) const
+{
+    // both counters only grow, so their sum changes whenever either does
+    return m_version + m_propertyToVersion.value(property);
+}
+
+QtProperty *QtObjectControllerPrivate::classProperty(const QMetaObject *metaObject)
+{
+    QtProperty *classProperty = m_classToProperty.value(metaObject, 0);
+    if (classProperty)
+        return classProperty;
+
+    const QtMetaClassSchema *schema = metaClassSchema(metaObject);
+    if (!schema)
+        return 0;
+
+    classProperty = m_manager->addProperty(QtVariantPropertyManager::groupTypeId(),
+                QLatin1String(metaObject->className()));
+    m_classToProperty[metaObject] = classProperty;
+    m_propertyToClass[classProperty] = metaObject;
+
+    for (const QtMetaPropertyInfo &info : schema->properties) {
+        const QString name = QLatin1String(info.metaProperty.name());
+        QtVariantProperty *subProperty = 0;
+        if (info.kind == QtMetaPropertyInfo::NonReadable) {
+            subProperty = m_readOnlyManager->addProperty(QVariant::String, name);
+            subProperty->setValue(QLatin1String("< Non Readable >"));
+        } else if (info.kind == QtMetaPropertyInfo::Enum) {
+            subProperty = m_manager->addProperty(info.type, name);
+            subProperty->setAttribute(QLatin1String(info.enumTable->isFlag() ? "flagNames" : "enumNames"),
+                        info.enumTable->names());
+            m_manager->setValueSource(subProperty, this);
+        } else if (!m_manager->isPropertyTypeSupported(info.type)) {
+            subProperty = m_readOnlyManager->addProperty(QVariant::String, name);
+            subProperty->setValue(QLatin1String("< Unknown Type >"));
+            subProperty->setEnabled(false);
+        } else if (!info.metaProperty.isWritable()) {
+            subProperty = m_readOnlyManager->addProperty(info.type, name + QLatin1String(" (Non Writable)"));
+            m_readOnlyManager->setValueSource(subProperty, this);
+        } else if (!info.metaProperty.isDesignable()) {
+            subProperty = m_readOnlyManager->addProperty(info.type, name + QLatin1String(" (Non Designable)"));
+            m_readOnlyManager->setValueSource(subProperty, this);
+        } else {
+            subProperty = m_manager->addProperty(info.type, name);
+            m_manager->setValueSource(subProperty, this);
+        }
+        classProperty->addSubProperty(subProperty);
+        m_propertyToInfo[subProperty] = &info;
+        m_infoToProperty[&info] = subProperty;
+    }
+    return classProperty;
+}
+
+void QtObjectControllerPrivate::updateValues()
+{
+    m_version++;
+    m_manager->updateValues();
+    m_readOnlyManager->updateValues();
+}
+
+// Connects to the NOTIFY signals of the controlled object's properties.
+// Properties without one are left to the poll timer.
+void QtObjectControllerPrivate::connectObject()
+{
+    const QtMetaClassSchema *schema = metaClassSchema(m_object->metaObject());
+    if (!schema)
+        return;
+
+    QObject::connect(m_object, SIGNAL(destroyed()), q_ptr, SLOT(slotObjectDestroyed()));
+
+    const QMetaObject *controllerMetaObject = q_ptr->metaObject();
+    const QMetaMethod notifiedSlot = controllerMetaObject->method(
+                controllerMetaObject->indexOfSlot("slotPropertyNotified()"));
+    for (const QMetaObject *metaObject : schema->classes) {
+        const QtMetaClassSchema *classSchema = metaClassSchema(metaObject);
+        for (const QtMetaPropertyInfo &info : classSchema->properties) {
+            QtProperty *property = m_infoToProperty.value(&info, 0);
+            if (!property || !info.read)
+                continue;
+            if (!info.metaProperty.hasNotifySignal()) {
+                m_polledProperties.append(property);
+                continue;
+            }
+            QList<QtProperty *> &properties = m_signalToProperties[info.metaProperty.notifySignalIndex()];
+            if (properties.isEmpty())
+                QObject::connect(m_object, info.metaProperty.notifySignal(), q_ptr, notifiedSlot);
+            properties.append(property);
+        }
+    }
+}
+
+void QtObjectControllerPrivate::disconnectObject()
+{
+    QObject::disconnect(m_object, 0, q_ptr, 0);
+    m_signalToProperties.clear();
+    m_polledProperties.clear();
+}
+
+void QtObjectControllerPrivate::invalidatePolledProperties()
+{
+    for (QtProperty *property : qAsConst(m_polledProperties))
+        m_propertyToVersion[property]++;
+}
+
+// Several notifications in one event loop pass result in one update.
+void QtObjectControllerPrivate::scheduleUpdate()
+{
+    if (!m_updateTimer) {
+        m_updateTimer = new QTimer(q_ptr);
+        m_updateTimer->setInterval(0);
+        m_updateTimer->setSingleShot(true);
+        QObject::connect(m_updateTimer, SIGNAL(timeout()), q_ptr, SLOT(slotUpdateValues()));
+    }
+    if (!m_updateTimer->isActive())
+        m_updateTimer->start();
+}
+
+void QtObjectControllerPrivate::updatePollTimer()
+{
+    const bool poll = m_object && m_pollInterval > 0 && !m_polledProperties.isEmpty();
+    if (!poll) {
+        if (m_pollTimer)
+            m_pollTimer->stop();
+        return;
+    }
+
+    if (!m_pollTimer) {
+        m_pollTimer = new QTimer(q_ptr);
+        QObject::connect(m_pollTimer, SIGNAL(timeout()), q_ptr, SLOT(slotPoll()));
+    }
+    m_pollTimer->start(m_pollInterval);
+}
+
+void QtObjectControllerPrivate::saveExpandedState()
+{
+    if (QtTreePropertyBrowser *browser = qobject_cast<QtTreePropertyBrowser *>(m_browser))
+        m_browserState = browser->saveState();
+}
+
+void QtObjectControllerPrivate::restoreExpandedState()
+{
+    if (QtTreePropertyBrowser *browser = qobject_cast<QtTreePropertyBrowser *>(m_browser))
+        browser->restoreState(m_browserState);
+}
+
+void QtObjectControllerPrivate::slotValueChanged(QtProperty *property, const QVariant &value)
+{
+    Q_UNUSED(value)
+    if (!m_propertyToInfo.contains(property))
+        return;
+
+    // the value source has written the new value already; properties
+    // changed as a side effect announce themselves through their NOTIFY
+    // signal, all others are read again
+    invalidatePolledProperties();
+    scheduleUpdate();
+}
+
+void QtObjectControllerPrivate::slotPropertyNotified()
+{
+    if (q_ptr->sender() != m_object)
+        return;
+
+    const auto it = m_signalToProperties.constFind(q_ptr->senderSignalIndex());
+    if (it == m_signalToProperties.constEnd())
+        return;
+
+    for (QtProperty *property : it.value())
+        m_propertyToVersion[property]++;
+    scheduleUpdate();
+}
+
+void QtObjectControllerPrivate::slotObjectDestroyed()
+{
+    q_ptr->setObject(0);
+}
+
+void QtObjectControllerPrivate::slotUpdateValues()
+{
+    m_manager->updateValues();
+    m_readOnlyManager->updateValues();
+}
+
+void QtObjectControllerPrivate::slotPoll()
+{
+    invalidatePolledProperties();
+    slotUpdateValues();
+}
+
+/*!
+    \class QtObjectController
+    \inmodule QtDesigner
+
+    \brief The QtObjectController class shows the properties of a
+    QObject and applies the user's changes to them.
+
+    Set the controlled object with setObject(). The controller shows
+    one group of properties per class in the object's hierarchy.
+
+    The reflection of a class is done once per application and is
+    cached: the property types, the read and write thunks and the
+    tables that map enum and flag values to the browser's indexes are
+    shared by all controllers. The properties created for a class are
+    kept by the controller, so inspecting another object of a known
+    class only reads the values of the displayed properties.
+*/
+
+/*!
+    Creates a controller with the given \a parent.
+*/
+QtObjectController::QtObjectController(QWidget *parent)
+    : QWidget(parent), d_ptr(new QtObjectControllerPrivate)
+{
+    d_ptr->q_ptr = this;
+
+    QtTreePropertyBrowser *browser = new QtTreePropertyBrowser(this);
+    browser->setRootIsDecorated(false);
+    d_ptr->m_browser = browser;
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->setMargin(0);
+    layout->addWidget(d_ptr->m_browser);
+
+    d_ptr->m_readOnlyManager = new QtVariantPropertyManager(this);
+    d_ptr->m_manager = new QtVariantPropertyManager(this);
+    QtVariantEditorFactory *factory = new QtVariantEditorFactory(this);
+    d_ptr->m_browser->setFactoryForManager(d_ptr->m_manager, factory);
+
+    connect(d_ptr->m_manager, SIGNAL(valueChanged(QtProperty *, const QVariant &)),
+                this, SLOT(slotValueChanged(QtProperty *, const QVariant &)));
+}
+
+/*!
+    Destroys this controller. The controlled object is not deleted.
+*/
+QtObjectController::~QtObjectController()
+{
+    // the managers outlive the private, which is their value source
+    for (auto it = d_ptr->m_propertyToInfo.constBegin(); it != d_ptr->m_propertyToInfo.constEnd(); ++it) {
+        QtProperty *property = const_cast<QtProperty *>(it.key());
+        static_cast<QtVariantPropertyManager *>(property->propertyManager())->setValueSource(property, 0);
+    }
+}
+
+/*!
+    Sets the controlled \a object. Passing 0 clears the controller.
+
+    \sa object()
+*/
+void QtObjectController::setObject(QObject *object)
+{
+    Q_D(QtObjectController);
+    if (d->m_object == object)
+        return;
+
+    if (d->m_object)
+        d->disconnectObject();
+
+    d->m_object = object;
+
+    const QtMetaClassSchema *schema = d->m_object ? metaClassSchema(d->m_object->metaObject()) : 0;
+    const QVector<const QMetaObject *> classes = schema ? schema->classes : QVector<const QMetaObject *>();
+
+    // keep the browser items of the classes shared with the previous object
+    int shared = 0;
+    while (shared < classes.count() && shared < d->m_topLevelProperties.count()
+                && d->m_propertyToClass.value(d->m_topLevelProperties.at(shared)) == classes.at(shared))
+        shared++;
+
+    if (shared < d->m_topLevelProperties.count()) {
+        d->saveExpandedState();
+        while (d->m_topLevelProperties.count() > shared)
+            d->m_browser->removeProperty(d->m_topLevelProperties.takeLast());
+    }
+
+    d->updateValues();
+
+    if (shared < classes.count()) {
+        for (int i = shared; i < classes.count(); i++) {
+            QtProperty *classProperty = d->classProperty(classes.at(i));
+            if (!classProperty)
+                continue;
+            d->m_topLevelProperties.append(classProperty);
+            d->m_browser->addProperty(classProperty);
+        }
+        d->restoreExpandedState();
+    }
+
+    if (d->m_object)
+        d->connectObject();
+    d->updatePollTimer();
+}
+
+/*!
+    Returns the controlled object.
+
+    \sa setObject()
+*/
+QObject *QtObjectController::object() const
+{
+    return d_ptr->m_object;
+}
+
+/*!
+    \property QtObjectController::pollInterval
+    \brief the interval, in milliseconds, at which properties without a
+    NOTIFY signal are refreshed
+
+    Properties with a NOTIFY signal are refreshed when the signal is
+    emitted; several notifications within one pass of the event loop
+    are combined into one update of the browser. Properties without a
+    NOTIFY signal are only refreshed after the user changed a
+    property, or every pollInterval milliseconds if the interval is
+    greater than 0. Only the displayed properties are read.
+
+    The default value is 0, which disables polling.
+*/
+int QtObjectController::pollInterval() const
+{
+    return d_ptr->m_pollInterval;
+}
+
+void QtObjectController::setPollInterval(int msec)
+{
+    Q_D(QtObjectController);
+    msec = qMax(0, msec);
+    if (d->m_pollInterval == msec)
+        return;
+
+    d->m_pollInterval = msec;
+    d->updatePollTimer();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qtobjectcontroller.cpp"
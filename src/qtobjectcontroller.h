@@ -37,28 +37,41 @@
 **
 ****************************************************************************/
 
-#ifndef OBJECTCONTROLLER_H
-#define OBJECTCONTROLLER_H
+#ifndef QTOBJECTCONTROLLER_H
+#define QTOBJECTCONTROLLER_H
 
-#include <QWidget>
+#include <QtWidgets/QWidget>
 
-class ObjectControllerPrivate;
+QT_BEGIN_NAMESPACE
 
-class ObjectController : public QWidget
+class QtProperty;
+class QtObjectControllerPrivate;
+
+class QtObjectController : public QWidget
 {
     Q_OBJECT
+    Q_PROPERTY(int pollInterval READ pollInterval WRITE setPollInterval)
 public:
-    ObjectController(QWidget *parent = 0);
-    ~ObjectController();
+    QtObjectController(QWidget *parent = 0);
+    ~QtObjectController();
 
     void setObject(QObject *object);
     QObject *object() const;
 
+    int pollInterval() const;
+    void setPollInterval(int msec);
+
 private:
-    ObjectControllerPrivate *d_ptr;
-    Q_DECLARE_PRIVATE(ObjectController)
-    Q_DISABLE_COPY(ObjectController)
+    QScopedPointer<QtObjectControllerPrivate> d_ptr;
+    Q_DECLARE_PRIVATE(QtObjectController)
+    Q_DISABLE_COPY_MOVE(QtObjectController)
     Q_PRIVATE_SLOT(d_func(), void slotValueChanged(QtProperty *, const QVariant &))
+    Q_PRIVATE_SLOT(d_func(), void slotPropertyNotified())
+    Q_PRIVATE_SLOT(d_func(), void slotObjectDestroyed())
+    Q_PRIVATE_SLOT(d_func(), void slotUpdateValues())
+    Q_PRIVATE_SLOT(d_func(), void slotPoll())
 };
 
+QT_END_NAMESPACE
+
 #endif
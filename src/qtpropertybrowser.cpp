@@ -40,6 +40,9 @@
 #include "qtpropertybrowser.h"
 #include <QtCore/QSet>
 #include <QtCore/QMap>
+#include <QtCore/QVector>
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
 #include <QtGui/QIcon>
 
 #if defined(Q_CC_MSVC)
@@ -79,8 +82,10 @@ public:
                 QtProperty *parentProperty) const;
     void propertyInserted(QtProperty *property, QtProperty *parentProperty,
                 QtProperty *afterProperty) const;
+    void notifyListeners(const QtPropertyChange &change) const;
 
     QSet<QtProperty *> m_properties;
+    QVector<QtPropertyChangeListener *> m_listeners;
 };
 
 /*!
@@ -285,6 +290,28 @@ bool QtProperty::hasValue() const
     return d_ptr->m_manager->hasValue(this);
 }
 
+/*!
+    Returns whether the property has subproperties that its manager
+    only creates on request, see createDeferredSubProperties().
+
+    \sa QtAbstractPropertyManager::hasDeferredSubProperties()
+*/
+bool QtProperty::hasDeferredSubProperties() const
+{
+    return d_ptr->m_manager->hasDeferredSubProperties(this);
+}
+
+/*!
+    Asks the manager to create the subproperties it deferred. Browsers
+    call this before showing the subproperties.
+
+    \sa hasDeferredSubProperties(), QtAbstractPropertyManager::createDeferredSubProperties()
+*/
+void QtProperty::createDeferredSubProperties()
+{
+    d_ptr->m_manager->createDeferredSubProperties(this);
+}
+
 /*!
     Returns an icon representing the current state of this property.
 
@@ -525,6 +552,7 @@ void QtProperty::propertyChanged()
 void QtAbstractPropertyManagerPrivate::propertyDestroyed(QtProperty *property)
 {
     if (m_properties.contains(property)) {
+        notifyListeners(QtPropertyChange(QtPropertyChange::Destroyed, property));
         emit q_ptr->propertyDestroyed(property);
         q_ptr->uninitializeProperty(property);
         m_properties.remove(property);
@@ -533,21 +561,103 @@ void QtAbstractPropertyManagerPrivate::propertyDestroyed(QtProperty *property)
 
 void QtAbstractPropertyManagerPrivate::propertyChanged(QtProperty *property) const
 {
+    notifyListeners(QtPropertyChange(QtPropertyChange::Changed, property));
     emit q_ptr->propertyChanged(property);
 }
 
 void QtAbstractPropertyManagerPrivate::propertyRemoved(QtProperty *property,
             QtProperty *parentProperty) const
 {
+    notifyListeners(QtPropertyChange(QtPropertyChange::Removed, property, parentProperty));
     emit q_ptr->propertyRemoved(property, parentProperty);
 }
 
 void QtAbstractPropertyManagerPrivate::propertyInserted(QtProperty *property,
             QtProperty *parentProperty, QtProperty *afterProperty) const
 {
+    notifyListeners(QtPropertyChange(QtPropertyChange::Inserted, property, parentProperty, afterProperty));
     emit q_ptr->propertyInserted(property, parentProperty, afterProperty);
 }
 
+void QtAbstractPropertyManagerPrivate::notifyListeners(const QtPropertyChange &change) const
+{
+    if (m_listeners.isEmpty())
+        return;
+    // a shallow copy, listeners may add or remove listeners while being notified
+    const QVector<QtPropertyChangeListener *> listeners = m_listeners;
+    for (QtPropertyChangeListener *listener : listeners)
+        listener->propertyChangeEvent(change);
+}
+
+/*!
+    \class QtInlineEditing
+    \inmodule QtDesigner
+
+    \brief The QtInlineEditing class lets property browsers edit simple
+    values without creating an editor widget.
+
+    A manager returns its implementation from
+    QtAbstractPropertyManager::inlineEditing(). The browser asks
+    inlineValueType() which kind of value a property holds, paints it from
+    inlineValue() and writes user changes back with setInlineValue().
+*/
+
+/*!
+    \enum QtInlineEditing::ValueType
+
+    \value NoInlineValue The property is edited with an editor widget.
+    \value BoolValue The value is a bool.
+    \value EnumValue The value is an index into inlineEnumNames().
+*/
+
+/*!
+    \fn QtInlineEditing::ValueType QtInlineEditing::inlineValueType(const QtProperty *property) const
+
+    Returns the kind of value \a property holds.
+*/
+
+/*!
+    \fn QVariant QtInlineEditing::inlineValue(const QtProperty *property) const
+
+    Returns the value of \a property.
+*/
+
+/*!
+    \fn void QtInlineEditing::setInlineValue(QtProperty *property, const QVariant &value)
+
+    Sets the value of \a property to \a value.
+*/
+
+/*!
+    Returns whether the value of \a property differs between the objects
+    it stands for. The default implementation returns false.
+*/
+bool QtInlineEditing::isInlineValueMixed(const QtProperty *property) const
+{
+    Q_UNUSED(property);
+    return false;
+}
+
+/*!
+    Returns the names of the enum \a property. The default implementation
+    returns an empty list.
+*/
+QStringList QtInlineEditing::inlineEnumNames(const QtProperty *property) const
+{
+    Q_UNUSED(property);
+    return QStringList();
+}
+
+/*!
+    Returns the icons of the enum \a property. The default implementation
+    returns an empty map.
+*/
+QMap<int, QIcon> QtInlineEditing::inlineEnumIcons(const QtProperty *property) const
+{
+    Q_UNUSED(property);
+    return QMap<int, QIcon>();
+}
+
 /*!
     \class QtAbstractPropertyManager
     \internal
@@ -664,6 +774,35 @@ void QtAbstractPropertyManagerPrivate::propertyInserted(QtProperty *property,
     \sa QtAbstractPropertyBrowser::setCurrentItem()
 */
 
+/*!
+    \fn void QtAbstractPropertyBrowser::populationStarted()
+
+    This signal is emitted when the browser starts creating items
+    asynchronously.
+
+    \sa populationTimeSlice, populationFinished()
+*/
+
+/*!
+    \fn void QtAbstractPropertyBrowser::populationProgress(int done, int total)
+
+    This signal is emitted after each pass of asynchronous item creation.
+    \a done is the number of subproperty items created so far and \a total
+    the number of subproperty items to be created.
+
+    \sa populationTimeSlice
+*/
+
+/*!
+    \fn void QtAbstractPropertyBrowser::populationFinished()
+
+    This signal is emitted when there are no more items to be created
+    asynchronously, either because all of them were created or because
+    the properties they belonged to were removed.
+
+    \sa populationTimeSlice, populationStarted()
+*/
+
 /*!
     Creates an abstract property manager with the given \a parent.
 */
@@ -671,7 +810,6 @@ QtAbstractPropertyManager::QtAbstractPropertyManager(QObject *parent)
     : QObject(parent), d_ptr(new QtAbstractPropertyManagerPrivate)
 {
     d_ptr->q_ptr = this;
-
 }
 
 /*!
@@ -717,6 +855,33 @@ bool QtAbstractPropertyManager::hasValue(const QtProperty *property) const
     return true;
 }
 
+/*!
+    Returns whether the given \a property has subproperties that are
+    not created yet. Browsers that can expand properties show such a
+    property as expandable and call createDeferredSubProperties() when
+    it is expanded; other browsers call it when the property is added.
+
+    The default implementation of this function returns false.
+
+    \sa QtProperty::hasDeferredSubProperties()
+*/
+bool QtAbstractPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
+{
+    Q_UNUSED(property);
+    return false;
+}
+
+/*!
+    Creates the deferred subproperties of the given \a property, see
+    hasDeferredSubProperties().
+
+    The default implementation of this function does nothing.
+*/
+void QtAbstractPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    Q_UNUSED(property);
+}
+
 /*!
     Returns an icon representing the current state of the given \a
     property.
@@ -813,6 +978,69 @@ void QtAbstractPropertyManager::uninitializeProperty(QtProperty *property)
    Q_UNUSED(property);
 }
 
+/*!
+    Registers \a listener to be called directly whenever a property of
+    this manager is inserted, changed, removed or destroyed.
+
+    Listeners are called in the order of registration, before the
+    corresponding propertyInserted(), propertyChanged(), propertyRemoved()
+    and propertyDestroyed() signals are emitted. Unlike connections to
+    these signals, listeners involve no meta-object dispatch, which is why
+    the property browsers and the built-in editor factories use them.
+    Listeners only learn about changes that a subclass reports with
+    notifyPropertyChanged(); emitting propertyChanged() directly reaches
+    the signal's connections only.
+
+    The manager does not take ownership of \a listener, which must be
+    removed with removeListener() before it is destroyed.
+
+    \sa removeListener(), QtPropertyChangeListener
+*/
+void QtAbstractPropertyManager::addListener(QtPropertyChangeListener *listener)
+{
+    if (!listener || d_ptr->m_listeners.contains(listener))
+        return;
+    d_ptr->m_listeners.append(listener);
+}
+
+/*!
+    Unregisters \a listener previously registered with addListener().
+
+    \sa addListener()
+*/
+void QtAbstractPropertyManager::removeListener(QtPropertyChangeListener *listener)
+{
+    d_ptr->m_listeners.removeAll(listener);
+}
+
+/*!
+    Returns the interface through which property browsers edit values
+    of this manager's properties in place, or 0 if the manager does not
+    support it. QtBoolPropertyManager, QtEnumPropertyManager and
+    QtVariantPropertyManager provide one.
+
+    \sa QtInlineEditing, QtTreePropertyBrowser::inlineEditors
+*/
+QtInlineEditing *QtAbstractPropertyManager::inlineEditing() const
+{
+    return 0;
+}
+
+/*!
+    Notifies the registered listeners and emits the propertyChanged()
+    signal for the given \a property.
+
+    Subclasses must call this function whenever the value of a property
+    changes; emitting propertyChanged() directly bypasses the listeners,
+    so property browsers and editors would not be updated.
+
+    \sa addListener()
+*/
+void QtAbstractPropertyManager::notifyPropertyChanged(QtProperty *property)
+{
+    d_ptr->propertyChanged(property);
+}
+
 ////////////////////////////////////
 
 /*!
@@ -859,6 +1087,131 @@ void QtAbstractPropertyManager::uninitializeProperty(QtProperty *property)
     \sa QtAbstractPropertyManager, QtAbstractPropertyBrowser
 */
 
+/*!
+    \enum QtAbstractEditorFactoryBase::CommitPolicy
+
+    The policy by which an editor passes the values it is edited to
+    on to the property manager. It is supported by the factories of
+    numeric editors, i.e. QtSpinBoxFactory, QtDoubleSpinBoxFactory,
+    QtSliderFactory and QtScrollBarFactory.
+
+    \value CommitImmediately Every change is committed as it happens.
+    \value CommitThrottled Changes are committed at most at the commit
+    rate of the factory. The first change is committed at once, the
+    last one when the interval has elapsed; values in between are only
+    shown by the editor itself.
+    \value CommitOnRelease Sliders commit when they are released and
+    spin boxes when editing finished, i.e. on Return or when they lose
+    focus. Steps made with the arrows, the mouse wheel or Page Up and
+    Page Down are held back until then.
+*/
+
+/*!
+    Returns the policy by which editors created by this factory commit
+    their values to the manager. The default is CommitImmediately.
+
+    \sa setCommitPolicy(), commitRate()
+*/
+QtAbstractEditorFactoryBase::CommitPolicy QtAbstractEditorFactoryBase::commitPolicy() const
+{
+    return m_commitPolicy;
+}
+
+/*!
+    Sets the commit policy of the editors created by this factory,
+    including the ones already open, to \a policy. Properties given a
+    policy of their own keep it.
+
+    \sa commitPolicy(), setCommitRate()
+*/
+void QtAbstractEditorFactoryBase::setCommitPolicy(CommitPolicy policy)
+{
+    if (m_commitPolicy == policy)
+        return;
+    m_commitPolicy = policy;
+    commitPolicyChanged(0);
+}
+
+/*!
+    Returns the commit policy that applies to the editors of the given
+    \a property.
+*/
+QtAbstractEditorFactoryBase::CommitPolicy QtAbstractEditorFactoryBase::commitPolicy(const QtProperty *property) const
+{
+    return m_propertyCommitPolicies.value(property, m_commitPolicy);
+}
+
+/*!
+    Sets the commit policy of the editors of the given \a property to
+    \a policy, overriding the policy of the factory. The setting is
+    dropped when the property is destroyed or its manager is removed
+    from the factory.
+*/
+void QtAbstractEditorFactoryBase::setCommitPolicy(const QtProperty *property, CommitPolicy policy)
+{
+    if (!property)
+        return;
+    m_propertyCommitPolicies[property] = policy;
+    commitPolicyChanged(property);
+}
+
+/*!
+    Returns the number of values per second a throttled editor commits
+    at most. The default is 20.
+
+    \sa setCommitRate(), CommitPolicy
+*/
+int QtAbstractEditorFactoryBase::commitRate() const
+{
+    return m_commitRate;
+}
+
+/*!
+    Sets the number of values per second a throttled editor commits at
+    most to \a rate, which is bounded to 1 to 1000.
+
+    \sa commitRate()
+*/
+void QtAbstractEditorFactoryBase::setCommitRate(int rate)
+{
+    m_commitRate = qBound(1, rate, 1000);
+}
+
+/*!
+    This function is called when the commit policy of the given \a
+    property changes, or with 0 when the policy of the factory changes.
+    Factories that support commit policies reimplement it to apply the
+    new policy to their open editors.
+
+    The default implementation does nothing.
+*/
+void QtAbstractEditorFactoryBase::commitPolicyChanged(const QtProperty *property)
+{
+    Q_UNUSED(property);
+}
+
+/*!
+    Drops the commit policy set for the given \a property, if any.
+    Factories call this when the property is destroyed.
+*/
+void QtAbstractEditorFactoryBase::removeCommitPolicy(const QtProperty *property)
+{
+    m_propertyCommitPolicies.remove(property);
+}
+
+/*!
+    Drops the commit policies set for the properties of the given \a
+    manager.
+*/
+void QtAbstractEditorFactoryBase::removeCommitPolicies(const QtAbstractPropertyManager *manager)
+{
+    if (m_propertyCommitPolicies.isEmpty())
+        return;
+    const QSet<QtProperty *> properties = manager->properties();
+    for (QtProperty *property : properties)
+        m_propertyCommitPolicies.remove(property);
+}
+
 /*!
     \fn virtual QWidget *QtAbstractEditorFactoryBase::createEditor(QtProperty *property,
         QWidget *parent) = 0
@@ -1210,46 +1563,145 @@ typedef QMap<QtAbstractPropertyManager *, QMap<QtAbstractEditorFactoryBase *,
 Q_GLOBAL_STATIC(Map1, m_viewToManagerToFactory)
 Q_GLOBAL_STATIC(Map2, m_managerToFactoryToViews)
 
-class QtAbstractPropertyBrowserPrivate
+class QtAbstractPropertyBrowserPrivate;
+
+// The top level properties of a browser together with the property graph
+// below them and the connections to the managers. Browsers attached with
+// QtAbstractPropertyBrowser::setSharedProperties() use a single instance,
+// which is deleted when the last of them detaches.
+class QtPropertyBrowserShare : public QtPropertyChangeListener
 {
-    QtAbstractPropertyBrowser *q_ptr;
-    Q_DECLARE_PUBLIC(QtAbstractPropertyBrowser)
 public:
-    QtAbstractPropertyBrowserPrivate();
+    ~QtPropertyBrowserShare();
+
+    void propertyChangeEvent(const QtPropertyChange &change);
+
+    void attach(QtAbstractPropertyBrowserPrivate *browser);
+    void detach(QtAbstractPropertyBrowserPrivate *browser);
 
     void insertSubTree(QtProperty *property,
             QtProperty *parentProperty);
     void removeSubTree(QtProperty *property,
             QtProperty *parentProperty);
-    void createBrowserIndexes(QtProperty *property, QtProperty *parentProperty, QtProperty *afterProperty);
-    void removeBrowserIndexes(QtProperty *property, QtProperty *parentProperty);
-    QtBrowserItem *createBrowserIndex(QtProperty *property, QtBrowserItem *parentIndex, QtBrowserItem *afterIndex);
-    void removeBrowserIndex(QtBrowserItem *index);
-    void clearIndex(QtBrowserItem *index);
+
+    QList<QtAbstractPropertyBrowserPrivate *> m_browsers;
+
+    QList<QtProperty *> m_subItems;
+    QMap<QtAbstractPropertyManager *, QList<QtProperty *> > m_managerToProperties;
+    QMap<QtProperty *, QList<QtProperty *> > m_propertyToParents;
 
     void slotPropertyInserted(QtProperty *property,
             QtProperty *parentProperty, QtProperty *afterProperty);
     void slotPropertyRemoved(QtProperty *property, QtProperty *parentProperty);
     void slotPropertyDestroyed(QtProperty *property);
     void slotPropertyDataChanged(QtProperty *property);
+};
 
-    QList<QtProperty *> m_subItems;
-    QMap<QtAbstractPropertyManager *, QList<QtProperty *> > m_managerToProperties;
-    QMap<QtProperty *, QList<QtProperty *> > m_propertyToParents;
+class QtAbstractPropertyBrowserPrivate
+{
+    QtAbstractPropertyBrowser *q_ptr;
+    Q_DECLARE_PUBLIC(QtAbstractPropertyBrowser)
+public:
+    QtAbstractPropertyBrowserPrivate();
+
+    void insertProperty(QtProperty *property, QtProperty *afterProperty, int pos);
+    void removeProperty(QtProperty *property, int pos);
+    void createTopLevelIndexes();
+    void removeTopLevelIndexes();
+
+    void createBrowserIndexes(QtProperty *property, QtProperty *parentProperty, QtProperty *afterProperty);
+    void removeBrowserIndexes(QtProperty *property, QtProperty *parentProperty);
+    QtBrowserItem *createBrowserIndex(QtProperty *property, QtBrowserItem *parentIndex, QtBrowserItem *afterIndex);
+    void removeBrowserIndex(QtBrowserItem *index);
+    void clearIndex(QtBrowserItem *index);
+
+    void propertyDataChanged(QtProperty *property);
+
+    void deferChildren(QtBrowserItem *index);
+    void cancelDeferredChildren(QtBrowserItem *index);
+    void slotPopulateNext();
+
+    QtPropertyBrowserShare *m_share;
 
     QMap<QtProperty *, QtBrowserItem *> m_topLevelPropertyToIndex;
     QList<QtBrowserItem *> m_topLevelIndexes;
     QMap<QtProperty *, QList<QtBrowserItem *> > m_propertyToIndexes;
 
     QtBrowserItem *m_currentItem;
+
+    // Asynchronous population: indexes whose children are still to be created,
+    // in breadth-first order so that upper levels show up first.
+    int m_populationTimeSlice;
+    QList<QtBrowserItem *> m_pendingIndexes;
+    QSet<QtBrowserItem *> m_pendingIndexSet;
+    QTimer *m_populationTimer;
+    bool m_populating;
+    int m_populationDone;
+    int m_populationTotal;
 };
 
 QtAbstractPropertyBrowserPrivate::QtAbstractPropertyBrowserPrivate() :
-   m_currentItem(0)
+   m_share(0),
+   m_currentItem(0),
+   m_populationTimeSlice(0),
+   m_populationTimer(0),
+   m_populating(false),
+   m_populationDone(0),
+   m_populationTotal(0)
 {
 }
 
-void QtAbstractPropertyBrowserPrivate::insertSubTree(QtProperty *property,
+static int subTreeSize(QtProperty *property)
+{
+    int size = 0;
+    const auto subList = property->subProperties();
+    for (QtProperty *subProperty : subList)
+        size += 1 + subTreeSize(subProperty);
+    return size;
+}
+
+QtPropertyBrowserShare::~QtPropertyBrowserShare()
+{
+    for (auto it = m_managerToProperties.cbegin(), end = m_managerToProperties.cend(); it != end; ++it)
+        it.key()->removeListener(this);
+}
+
+void QtPropertyBrowserShare::propertyChangeEvent(const QtPropertyChange &change)
+{
+    switch (change.type) {
+    case QtPropertyChange::Inserted:
+        slotPropertyInserted(change.property, change.parent, change.after);
+        break;
+    case QtPropertyChange::Changed:
+        slotPropertyDataChanged(change.property);
+        break;
+    case QtPropertyChange::Removed:
+        slotPropertyRemoved(change.property, change.parent);
+        break;
+    case QtPropertyChange::Destroyed:
+        slotPropertyDestroyed(change.property);
+        break;
+    }
+}
+
+void QtPropertyBrowserShare::attach(QtAbstractPropertyBrowserPrivate *browser)
+{
+    m_browsers.append(browser);
+    browser->m_share = this;
+    browser->createTopLevelIndexes();
+}
+
+void QtPropertyBrowserShare::detach(QtAbstractPropertyBrowserPrivate *browser)
+{
+    browser->removeTopLevelIndexes();
+    browser->m_share = 0;
+    m_browsers.removeAll(browser);
+    // deleting the share unregisters it from the managers
+    if (m_browsers.isEmpty())
+        delete this;
+}
+
+void QtPropertyBrowserShare::insertSubTree(QtProperty *property,
             QtProperty *parentProperty)
 {
     if (m_propertyToParents.contains(property)) {
@@ -1263,18 +1715,8 @@ void QtAbstractPropertyBrowserPrivate::insertSubTree(QtProperty *property,
     }
     QtAbstractPropertyManager *manager = property->propertyManager();
     if (m_managerToProperties[manager].isEmpty()) {
-        // connect manager's signals
-        q_ptr->connect(manager, SIGNAL(propertyInserted(QtProperty *,
-                            QtProperty *, QtProperty *)),
-                q_ptr, SLOT(slotPropertyInserted(QtProperty *,
-                            QtProperty *, QtProperty *)));
-        q_ptr->connect(manager, SIGNAL(propertyRemoved(QtProperty *,
-                            QtProperty *)),
-                q_ptr, SLOT(slotPropertyRemoved(QtProperty*,QtProperty*)));
-        q_ptr->connect(manager, SIGNAL(propertyDestroyed(QtProperty*)),
-                q_ptr, SLOT(slotPropertyDestroyed(QtProperty*)));
-        q_ptr->connect(manager, SIGNAL(propertyChanged(QtProperty*)),
-                q_ptr, SLOT(slotPropertyDataChanged(QtProperty*)));
+        // listen to manager's changes
+        manager->addListener(this);
     }
     m_managerToProperties[manager].append(property);
     m_propertyToParents[property].append(parentProperty);
@@ -1284,7 +1726,7 @@ void QtAbstractPropertyBrowserPrivate::insertSubTree(QtProperty *property,
         insertSubTree(subProperty, property);
 }
 
-void QtAbstractPropertyBrowserPrivate::removeSubTree(QtProperty *property,
+void QtPropertyBrowserShare::removeSubTree(QtProperty *property,
             QtProperty *parentProperty)
 {
     if (!m_propertyToParents.contains(property)) {
@@ -1300,18 +1742,8 @@ void QtAbstractPropertyBrowserPrivate::removeSubTree(QtProperty *property,
     QtAbstractPropertyManager *manager = property->propertyManager();
     m_managerToProperties[manager].removeAll(property);
     if (m_managerToProperties[manager].isEmpty()) {
-        // disconnect manager's signals
-        q_ptr->disconnect(manager, SIGNAL(propertyInserted(QtProperty *,
-                            QtProperty *, QtProperty *)),
-                q_ptr, SLOT(slotPropertyInserted(QtProperty *,
-                            QtProperty *, QtProperty *)));
-        q_ptr->disconnect(manager, SIGNAL(propertyRemoved(QtProperty *,
-                            QtProperty *)),
-                q_ptr, SLOT(slotPropertyRemoved(QtProperty*,QtProperty*)));
-        q_ptr->disconnect(manager, SIGNAL(propertyDestroyed(QtProperty*)),
-                q_ptr, SLOT(slotPropertyDestroyed(QtProperty*)));
-        q_ptr->disconnect(manager, SIGNAL(propertyChanged(QtProperty*)),
-                q_ptr, SLOT(slotPropertyDataChanged(QtProperty*)));
+        // stop listening to manager's changes
+        manager->removeListener(this);
 
         m_managerToProperties.remove(manager);
     }
@@ -1339,8 +1771,14 @@ void QtAbstractPropertyBrowserPrivate::createBrowserIndexes(QtProperty *property
         if (it == m_propertyToIndexes.constEnd())
             return;
 
-        for (QtBrowserItem *idx : it.value())
-            parentToAfter[idx] = 0;
+        for (QtBrowserItem *idx : it.value()) {
+            // Children of a deferred index are all created when it is
+            // populated, this one included.
+            if (m_pendingIndexSet.contains(idx))
+                m_populationTotal += 1 + subTreeSize(property);
+            else
+                parentToAfter[idx] = 0;
+        }
     } else {
         parentToAfter[0] = 0;
     }
@@ -1353,6 +1791,10 @@ void QtAbstractPropertyBrowserPrivate::createBrowserIndexes(QtProperty *property
 QtBrowserItem *QtAbstractPropertyBrowserPrivate::createBrowserIndex(QtProperty *property,
         QtBrowserItem *parentIndex, QtBrowserItem *afterIndex)
 {
+    // Before the index exists, so that the insertions do not reach it.
+    if (!q_ptr->createsSubPropertiesOnExpand() && property->hasDeferredSubProperties())
+        property->createDeferredSubProperties();
+
     QtBrowserItem *newIndex = new QtBrowserItem(q_ptr, property, parentIndex);
     if (parentIndex) {
         parentIndex->d_ptr->addChild(newIndex, afterIndex);
@@ -1364,6 +1806,11 @@ QtBrowserItem *QtAbstractPropertyBrowserPrivate::createBrowserIndex(QtProperty *
 
     q_ptr->itemInserted(newIndex, afterIndex);
 
+    if (m_populationTimeSlice > 0) {
+        deferChildren(newIndex);
+        return newIndex;
+    }
+
     const auto subItems = property->subProperties();
     QtBrowserItem *afterChild = 0;
     for (QtProperty *child : subItems)
@@ -1404,6 +1851,8 @@ void QtAbstractPropertyBrowserPrivate::removeBrowserIndex(QtBrowserItem *index)
         m_topLevelIndexes.removeAll(index);
     }
 
+    cancelDeferredChildren(index);
+
     QtProperty *property = index->property();
 
     m_propertyToIndexes[property].removeAll(index);
@@ -1413,6 +1862,81 @@ void QtAbstractPropertyBrowserPrivate::removeBrowserIndex(QtBrowserItem *index)
     delete index;
 }
 
+void QtAbstractPropertyBrowserPrivate::deferChildren(QtBrowserItem *index)
+{
+    if (index->property()->subProperties().isEmpty())
+        return;
+
+    // Indexes created by slotPopulateNext() were already counted when their
+    // top level ancestor was deferred.
+    if (!m_populating) {
+        const bool started = m_pendingIndexes.isEmpty();
+        m_populationTotal += subTreeSize(index->property());
+        if (started)
+            emit q_ptr->populationStarted();
+    }
+
+    m_pendingIndexes.append(index);
+    m_pendingIndexSet.insert(index);
+
+    if (!m_populationTimer) {
+        m_populationTimer = new QTimer(q_ptr);
+        m_populationTimer->setSingleShot(true);
+        m_populationTimer->setInterval(0);
+        q_ptr->connect(m_populationTimer, SIGNAL(timeout()), q_ptr, SLOT(slotPopulateNext()));
+    }
+    if (!m_populationTimer->isActive())
+        m_populationTimer->start();
+}
+
+void QtAbstractPropertyBrowserPrivate::cancelDeferredChildren(QtBrowserItem *index)
+{
+    // The stale entry in m_pendingIndexes is skipped by slotPopulateNext(),
+    // which is still scheduled and reports the end of population.
+    if (m_pendingIndexSet.remove(index) && m_pendingIndexSet.isEmpty())
+        m_pendingIndexes.clear();
+}
+
+void QtAbstractPropertyBrowserPrivate::slotPopulateNext()
+{
+    QElapsedTimer sliceTimer;
+    sliceTimer.start();
+
+    m_populating = true;
+    while (!m_pendingIndexes.isEmpty()) {
+        QtBrowserItem *index = m_pendingIndexes.takeFirst();
+        if (!m_pendingIndexSet.remove(index))
+            continue;
+
+        const auto subItems = index->property()->subProperties();
+        QtBrowserItem *afterChild = 0;
+        for (QtProperty *child : subItems) {
+            afterChild = createBrowserIndex(child, index, afterChild);
+            // Without a time slice the whole subtree was created at once.
+            m_populationDone += m_populationTimeSlice > 0 ? 1 : 1 + subTreeSize(child);
+        }
+
+        if (m_populationTimeSlice > 0 && sliceTimer.elapsed() >= m_populationTimeSlice)
+            break;
+    }
+    m_populating = false;
+
+    if (!m_pendingIndexSet.isEmpty()) {
+        emit q_ptr->populationProgress(m_populationDone, m_populationTotal);
+        m_populationTimer->start();
+        return;
+    }
+
+    m_pendingIndexes.clear();
+    // Items removed while still deferred were never created; report
+    // what was done rather than what was expected.
+    const int done = m_populationDone;
+    m_populationDone = 0;
+    m_populationTotal = 0;
+    emit q_ptr->populationProgress(done, done);
+    emit q_ptr->populationFinished();
+}
+
 void QtAbstractPropertyBrowserPrivate::clearIndex(QtBrowserItem *index)
 {
     const auto children = index->children();
@@ -1421,38 +1945,93 @@ void QtAbstractPropertyBrowserPrivate::clearIndex(QtBrowserItem *index)
     delete index;
 }
 
-void QtAbstractPropertyBrowserPrivate::slotPropertyInserted(QtProperty *property,
+void QtPropertyBrowserShare::slotPropertyInserted(QtProperty *property,
         QtProperty *parentProperty, QtProperty *afterProperty)
 {
     if (!m_propertyToParents.contains(parentProperty))
         return;
-    createBrowserIndexes(property, parentProperty, afterProperty);
+    const auto browsers = m_browsers;
+    for (QtAbstractPropertyBrowserPrivate *browser : browsers)
+        browser->createBrowserIndexes(property, parentProperty, afterProperty);
     insertSubTree(property, parentProperty);
     //q_ptr->propertyInserted(property, parentProperty, afterProperty);
 }
 
-void QtAbstractPropertyBrowserPrivate::slotPropertyRemoved(QtProperty *property,
+void QtPropertyBrowserShare::slotPropertyRemoved(QtProperty *property,
         QtProperty *parentProperty)
 {
     if (!m_propertyToParents.contains(parentProperty))
         return;
     removeSubTree(property, parentProperty); // this line should be probably moved down after propertyRemoved call
     //q_ptr->propertyRemoved(property, parentProperty);
-    removeBrowserIndexes(property, parentProperty);
+    const auto browsers = m_browsers;
+    for (QtAbstractPropertyBrowserPrivate *browser : browsers)
+        browser->removeBrowserIndexes(property, parentProperty);
 }
 
-void QtAbstractPropertyBrowserPrivate::slotPropertyDestroyed(QtProperty *property)
+void QtPropertyBrowserShare::slotPropertyDestroyed(QtProperty *property)
 {
-    if (!m_subItems.contains(property))
+    const int pos = m_subItems.indexOf(property);
+    if (pos < 0)
         return;
-    q_ptr->removeProperty(property);
+    m_browsers.first()->removeProperty(property, pos);
 }
 
-void QtAbstractPropertyBrowserPrivate::slotPropertyDataChanged(QtProperty *property)
+void QtPropertyBrowserShare::slotPropertyDataChanged(QtProperty *property)
 {
     if (!m_propertyToParents.contains(property))
         return;
+    const auto browsers = m_browsers;
+    for (QtAbstractPropertyBrowserPrivate *browser : browsers)
+        browser->propertyDataChanged(property);
+}
+
+void QtAbstractPropertyBrowserPrivate::insertProperty(QtProperty *property,
+        QtProperty *afterProperty, int pos)
+{
+    const auto browsers = m_share->m_browsers;
+    for (QtAbstractPropertyBrowserPrivate *browser : browsers)
+        browser->createBrowserIndexes(property, 0, afterProperty);
+
+    // traverse inserted subtree and connect to manager's signals
+    m_share->insertSubTree(property, 0);
+
+    m_share->m_subItems.insert(pos, property);
+    //propertyInserted(property, 0, properAfterProperty);
+}
+
+void QtAbstractPropertyBrowserPrivate::removeProperty(QtProperty *property, int pos)
+{
+    m_share->m_subItems.removeAt(pos); //perhaps this two lines
+    m_share->removeSubTree(property, 0); //should be moved down after propertyRemoved call.
+    //propertyRemoved(property, 0);
 
+    const auto browsers = m_share->m_browsers;
+    for (QtAbstractPropertyBrowserPrivate *browser : browsers)
+        browser->removeBrowserIndexes(property, 0);
+
+    // when item is deleted, item will call removeItem for top level items,
+    // and itemRemoved for nested items.
+}
+
+void QtAbstractPropertyBrowserPrivate::createTopLevelIndexes()
+{
+    QtProperty *afterProperty = 0;
+    for (QtProperty *property : qAsConst(m_share->m_subItems)) {
+        createBrowserIndexes(property, 0, afterProperty);
+        afterProperty = property;
+    }
+}
+
+void QtAbstractPropertyBrowserPrivate::removeTopLevelIndexes()
+{
+    const auto indexes = m_topLevelIndexes;
+    for (auto rit = indexes.crbegin(), rend = indexes.crend(); rit != rend; ++rit)
+        removeBrowserIndex(*rit);
+}
+
+void QtAbstractPropertyBrowserPrivate::propertyDataChanged(QtProperty *property)
+{
     const auto it = m_propertyToIndexes.constFind(property);
     if (it == m_propertyToIndexes.constEnd())
         return;
@@ -1641,6 +2220,7 @@ QtAbstractPropertyBrowser::QtAbstractPropertyBrowser(QWidget *parent)
     : QWidget(parent), d_ptr(new QtAbstractPropertyBrowserPrivate)
 {
     d_ptr->q_ptr = this;
+    (new QtPropertyBrowserShare)->attach(d_func());
 
 }
 
@@ -1661,6 +2241,8 @@ QtAbstractPropertyBrowser::~QtAbstractPropertyBrowser()
     const auto indexes = topLevelItems();
     for (QtBrowserItem *item : indexes)
         d_ptr->clearIndex(item);
+    d_ptr->m_topLevelIndexes.clear();
+    d_ptr->m_share->detach(d_func());
 }
 
 /*!
@@ -1673,7 +2255,7 @@ QtAbstractPropertyBrowser::~QtAbstractPropertyBrowser()
 */
 QList<QtProperty *> QtAbstractPropertyBrowser::properties() const
 {
-    return d_ptr->m_subItems;
+    return d_ptr->m_share->m_subItems;
 }
 
 /*!
@@ -1743,8 +2325,8 @@ void QtAbstractPropertyBrowser::clear()
 QtBrowserItem *QtAbstractPropertyBrowser::addProperty(QtProperty *property)
 {
     QtProperty *afterProperty = 0;
-    if (d_ptr->m_subItems.count() > 0)
-        afterProperty = d_ptr->m_subItems.last();
+    if (d_ptr->m_share->m_subItems.count() > 0)
+        afterProperty = d_ptr->m_share->m_subItems.last();
     return insertProperty(property, afterProperty);
 }
 
@@ -1783,13 +2365,7 @@ QtBrowserItem *QtAbstractPropertyBrowser::insertProperty(QtProperty *property,
         }
         pos++;
     }
-    d_ptr->createBrowserIndexes(property, 0, afterProperty);
-
-    // traverse inserted subtree and connect to manager's signals
-    d_ptr->insertSubTree(property, 0);
-
-    d_ptr->m_subItems.insert(newPos, property);
-    //propertyInserted(property, 0, properAfterProperty);
+    d_ptr->insertProperty(property, afterProperty, newPos);
     return topLevelItem(property);
 }
 
@@ -1813,21 +2389,30 @@ void QtAbstractPropertyBrowser::removeProperty(QtProperty *property)
     int pos = 0;
     while (pos < pendingList.count()) {
         if (pendingList.at(pos) == property) {
-            d_ptr->m_subItems.removeAt(pos); //perhaps this two lines
-            d_ptr->removeSubTree(property, 0); //should be moved down after propertyRemoved call.
-            //propertyRemoved(property, 0);
-
-            d_ptr->removeBrowserIndexes(property, 0);
-
-            // when item is deleted, item will call removeItem for top level items,
-            // and itemRemoved for nested items.
-
+            d_ptr->removeProperty(property, pos);
             return;
         }
         pos++;
     }
 }
 
+/*!
+    Returns true if an editor factory is associated with the manager of
+    the given \a property in \e this property browser, i.e. if
+    createEditor() can provide an editing widget for it. Browsers that
+    edit some values without a widget use this to decide whether the
+    property is editable at all.
+
+    \sa setFactoryForManager(), createEditor()
+*/
+bool QtAbstractPropertyBrowser::hasEditorFactory(QtProperty *property) const
+{
+    const auto it = m_viewToManagerToFactory()->constFind(const_cast<QtAbstractPropertyBrowser *>(this));
+    if (it == m_viewToManagerToFactory()->constEnd())
+        return false;
+    return it.value().contains(property->propertyManager());
+}
+
 /*!
     Creates an editing widget (with the given \a parent) for the given
     \a property according to the previously established associations
@@ -1869,6 +2454,21 @@ QWidget *QtAbstractPropertyBrowser::createEditor(QtProperty *property,
     return w;
 }
 
+/*!
+    Returns whether the browser creates the deferred subproperties of a
+    property (see QtProperty::hasDeferredSubProperties()) only when the
+    property is expanded. In that case the browser must show such
+    properties as expandable and call
+    QtProperty::createDeferredSubProperties() when they are expanded.
+
+    The default implementation returns false, and the subproperties are
+    created as soon as the property is added to the browser.
+*/
+bool QtAbstractPropertyBrowser::createsSubPropertiesOnExpand() const
+{
+    return false;
+}
+
 bool QtAbstractPropertyBrowser::addFactory(QtAbstractPropertyManager *abstractManager,
             QtAbstractEditorFactoryBase *abstractFactory)
 {
@@ -1923,6 +2523,88 @@ void QtAbstractPropertyBrowser::unsetFactoryForManager(QtAbstractPropertyManager
     }
 }
 
+/*!
+    Makes this browser show the same properties as the given \a browser.
+
+    The browsers then share their list of top level properties, the
+    property graph below them and the connections to the property
+    managers. Adding or removing a property in any of them affects all
+    of them, and each change of a property is dispatched once to all
+    sharing browsers. Every browser keeps its own items, current item and
+    editor factories.
+
+    The properties previously shown by this browser are removed from it.
+    Passing 0 stops sharing, leaving this browser empty.
+
+    \sa properties()
+*/
+void QtAbstractPropertyBrowser::setSharedProperties(QtAbstractPropertyBrowser *browser)
+{
+    QtPropertyBrowserShare *oldShare = d_ptr->m_share;
+    if (browser) {
+        if (browser->d_ptr->m_share == oldShare)
+            return;
+        oldShare->detach(d_func());
+        browser->d_ptr->m_share->attach(d_func());
+    } else {
+        if (oldShare->m_browsers.count() == 1)
+            return;
+        oldShare->detach(d_func());
+        (new QtPropertyBrowserShare)->attach(d_func());
+    }
+}
+
+/*!
+    \property QtAbstractPropertyBrowser::populationTimeSlice
+    \brief the time budget in milliseconds spent on creating items per event loop pass.
+
+    By default the time slice is 0 and addProperty() and insertProperty()
+    create the complete item subtree of the inserted property before
+    returning.
+
+    If the time slice is positive, only the item of the inserted property
+    itself is created immediately. Its subproperties are then created
+    level by level in subsequent passes of the event loop, each pass
+    spending at most roughly the given number of milliseconds, so that
+    top level items become visible first and the user interface stays
+    responsive while a large property tree is being populated. Removing a
+    property (e.g. by calling clear() when another object gets selected)
+    safely discards the pending part of its subtree.
+
+    Setting the time slice back to 0 completes any pending population
+    immediately.
+
+    \sa isPopulating(), populationStarted(), populationProgress(), populationFinished()
+*/
+int QtAbstractPropertyBrowser::populationTimeSlice() const
+{
+    return d_ptr->m_populationTimeSlice;
+}
+
+void QtAbstractPropertyBrowser::setPopulationTimeSlice(int msec)
+{
+    msec = qMax(0, msec);
+    if (d_ptr->m_populationTimeSlice == msec)
+        return;
+
+    d_ptr->m_populationTimeSlice = msec;
+    if (msec == 0 && d_ptr->m_populationTimer && d_ptr->m_populationTimer->isActive()) {
+        d_ptr->m_populationTimer->stop();
+        d_ptr->slotPopulateNext();
+    }
+}
+
+/*!
+    Returns true if items of inserted properties are still being created
+    asynchronously; otherwise returns false.
+
+    \sa populationTimeSlice
+*/
+bool QtAbstractPropertyBrowser::isPopulating() const
+{
+    return !d_ptr->m_pendingIndexSet.isEmpty();
+}
+
 /*!
     Returns the current item in the property browser.
 
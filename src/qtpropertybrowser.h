@@ -42,6 +42,9 @@
 
 #include <QtWidgets/QWidget>
 #include <QtCore/QSet>
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QVariant>
 
 QT_BEGIN_NAMESPACE
 
@@ -70,6 +73,9 @@ public:
     QIcon valueIcon() const;
     QString valueText() const;
 
+    bool hasDeferredSubProperties() const;
+    void createDeferredSubProperties();
+
     void setToolTip(const QString &text) { setValueToolTip(text); }  // Compatibility
     void setValueToolTip(const QString &text);
     void setDescriptionToolTip(const QString &text);
@@ -90,6 +96,53 @@ private:
     QScopedPointer<QtPropertyPrivate> d_ptr;
 };
 
+class QtPropertyChange
+{
+public:
+    enum Type
+    {
+        Inserted,
+        Changed,
+        Removed,
+        Destroyed
+    };
+
+    QtPropertyChange(Type type, QtProperty *property,
+                QtProperty *parent = 0, QtProperty *after = 0)
+        : type(type), property(property), parent(parent), after(after) {}
+
+    Type type;
+    QtProperty *property;
+    QtProperty *parent;
+    QtProperty *after;
+};
+
+class QtPropertyChangeListener
+{
+public:
+    virtual ~QtPropertyChangeListener() {}
+    virtual void propertyChangeEvent(const QtPropertyChange &change) = 0;
+};
+
+class QtInlineEditing
+{
+public:
+    enum ValueType
+    {
+        NoInlineValue,
+        BoolValue,
+        EnumValue
+    };
+
+    virtual ~QtInlineEditing() {}
+    virtual ValueType inlineValueType(const QtProperty *property) const = 0;
+    virtual QVariant inlineValue(const QtProperty *property) const = 0;
+    virtual void setInlineValue(QtProperty *property, const QVariant &value) = 0;
+    virtual bool isInlineValueMixed(const QtProperty *property) const;
+    virtual QStringList inlineEnumNames(const QtProperty *property) const;
+    virtual QMap<int, QIcon> inlineEnumIcons(const QtProperty *property) const;
+};
+
 class QtAbstractPropertyManagerPrivate;
 
 class QtAbstractPropertyManager : public QObject
@@ -104,6 +157,11 @@ public:
     void clear() const;
 
     QtProperty *addProperty(const QString &name = QString());
+
+    void addListener(QtPropertyChangeListener *listener);
+    void removeListener(QtPropertyChangeListener *listener);
+
+    virtual QtInlineEditing *inlineEditing() const;
 Q_SIGNALS:
 
     void propertyInserted(QtProperty *property,
@@ -118,6 +176,9 @@ protected:
     virtual void initializeProperty(QtProperty *property) = 0;
     virtual void uninitializeProperty(QtProperty *property);
     virtual QtProperty *createProperty();
+    virtual bool hasDeferredSubProperties(const QtProperty *property) const;
+    virtual void createDeferredSubProperties(QtProperty *property);
+    void notifyPropertyChanged(QtProperty *property);
 private:
     friend class QtProperty;
     QScopedPointer<QtAbstractPropertyManagerPrivate> d_ptr;
@@ -129,14 +190,37 @@ class QtAbstractEditorFactoryBase : public QObject
 {
     Q_OBJECT
 public:
+    enum CommitPolicy
+    {
+        CommitImmediately,
+        CommitThrottled,
+        CommitOnRelease
+    };
+    Q_ENUM(CommitPolicy)
+
     virtual QWidget *createEditor(QtProperty *property, QWidget *parent) = 0;
+
+    CommitPolicy commitPolicy() const;
+    void setCommitPolicy(CommitPolicy policy);
+    CommitPolicy commitPolicy(const QtProperty *property) const;
+    void setCommitPolicy(const QtProperty *property, CommitPolicy policy);
+
+    int commitRate() const;
+    void setCommitRate(int rate);
 protected:
     explicit QtAbstractEditorFactoryBase(QObject *parent = 0)
-        : QObject(parent) {}
+        : QObject(parent), m_commitPolicy(CommitImmediately), m_commitRate(20) {}
 
     virtual void breakConnection(QtAbstractPropertyManager *manager) = 0;
+    virtual void commitPolicyChanged(const QtProperty *property);
+    void removeCommitPolicy(const QtProperty *property);
+    void removeCommitPolicies(const QtAbstractPropertyManager *manager);
 protected Q_SLOTS:
     virtual void managerDestroyed(QObject *manager) = 0;
+private:
+    CommitPolicy m_commitPolicy;
+    QHash<const QtProperty *, CommitPolicy> m_propertyCommitPolicies;
+    int m_commitRate;
 
     friend class QtAbstractPropertyBrowser;
 };
@@ -148,11 +232,8 @@ public:
     explicit QtAbstractEditorFactory(QObject *parent) : QtAbstractEditorFactoryBase(parent) {}
     QWidget *createEditor(QtProperty *property, QWidget *parent)
     {
-        for (PropertyManager *manager : qAsConst(m_managers)) {
-            if (manager == property->propertyManager()) {
-                return createEditor(manager, property, parent);
-            }
-        }
+        if (PropertyManager *manager = m_managerIndex.value(property->propertyManager(), 0))
+            return createEditor(manager, property, parent);
         return 0;
     }
     void addPropertyManager(PropertyManager *manager)
@@ -160,6 +241,7 @@ public:
         if (m_managers.contains(manager))
             return;
         m_managers.insert(manager);
+        m_managerIndex.insert(manager, manager);
         connectPropertyManager(manager);
         connect(manager, SIGNAL(destroyed(QObject *)),
                     this, SLOT(managerDestroyed(QObject *)));
@@ -171,7 +253,9 @@ public:
         disconnect(manager, SIGNAL(destroyed(QObject *)),
                     this, SLOT(managerDestroyed(QObject *)));
         disconnectPropertyManager(manager);
+        removeCommitPolicies(manager);
         m_managers.remove(manager);
+        m_managerIndex.remove(manager);
     }
     QSet<PropertyManager *> propertyManagers() const
     {
@@ -179,13 +263,7 @@ public:
     }
     PropertyManager *propertyManager(QtProperty *property) const
     {
-        QtAbstractPropertyManager *manager = property->propertyManager();
-        for (PropertyManager *m : qAsConst(m_managers)) {
-            if (m == manager) {
-                return m;
-            }
-        }
-        return 0;
+        return m_managerIndex.value(property->propertyManager(), 0);
     }
 protected:
     virtual void connectPropertyManager(PropertyManager *manager) = 0;
@@ -194,25 +272,20 @@ protected:
     virtual void disconnectPropertyManager(PropertyManager *manager) = 0;
     void managerDestroyed(QObject *manager)
     {
-        for (PropertyManager *m : qAsConst(m_managers)) {
-            if (m == manager) {
-                m_managers.remove(m);
-                return;
-            }
-        }
+        // only the address is used, the manager is already being destroyed
+        if (PropertyManager *m = m_managerIndex.take(static_cast<QtAbstractPropertyManager *>(manager)))
+            m_managers.remove(m);
     }
 private:
     void breakConnection(QtAbstractPropertyManager *manager)
     {
-        for (PropertyManager *m : qAsConst(m_managers)) {
-            if (m == manager) {
-                removePropertyManager(m);
-                return;
-            }
-        }
+        if (PropertyManager *m = m_managerIndex.value(manager, 0))
+            removePropertyManager(m);
     }
 private:
     QSet<PropertyManager *> m_managers;
+    // resolves a property's manager without comparing it to every managed one
+    QHash<QtAbstractPropertyManager *, PropertyManager *> m_managerIndex;
     friend class QtAbstractPropertyEditor;
 };
 
@@ -238,6 +311,7 @@ class QtAbstractPropertyBrowserPrivate;
 class QtAbstractPropertyBrowser : public QWidget
 {
     Q_OBJECT
+    Q_PROPERTY(int populationTimeSlice READ populationTimeSlice WRITE setPopulationTimeSlice)
 public:
 
     explicit QtAbstractPropertyBrowser(QWidget *parent = 0);
@@ -261,12 +335,22 @@ public:
 
     void unsetFactoryForManager(QtAbstractPropertyManager *manager);
 
+    void setSharedProperties(QtAbstractPropertyBrowser *browser);
+
     QtBrowserItem *currentItem() const;
     void setCurrentItem(QtBrowserItem *);
 
+    int populationTimeSlice() const;
+    void setPopulationTimeSlice(int msec);
+    bool isPopulating() const;
+
 Q_SIGNALS:
     void currentItemChanged(QtBrowserItem *);
 
+    void populationStarted();
+    void populationProgress(int done, int total);
+    void populationFinished();
+
 public Q_SLOTS:
 
     QtBrowserItem *addProperty(QtProperty *property);
@@ -281,6 +365,8 @@ protected:
     virtual void itemChanged(QtBrowserItem *item) = 0;
 
     virtual QWidget *createEditor(QtProperty *property, QWidget *parent);
+    virtual bool createsSubPropertiesOnExpand() const;
+    bool hasEditorFactory(QtProperty *property) const;
 private:
 
     bool addFactory(QtAbstractPropertyManager *abstractManager,
@@ -289,12 +375,7 @@ private:
     QScopedPointer<QtAbstractPropertyBrowserPrivate> d_ptr;
     Q_DECLARE_PRIVATE(QtAbstractPropertyBrowser)
     Q_DISABLE_COPY_MOVE(QtAbstractPropertyBrowser)
-    Q_PRIVATE_SLOT(d_func(), void slotPropertyInserted(QtProperty *,
-                            QtProperty *, QtProperty *))
-    Q_PRIVATE_SLOT(d_func(), void slotPropertyRemoved(QtProperty *,
-                            QtProperty *))
-    Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
-    Q_PRIVATE_SLOT(d_func(), void slotPropertyDataChanged(QtProperty *))
+    Q_PRIVATE_SLOT(d_func(), void slotPopulateNext())
 
 };
 
@@ -12,6 +12,7 @@ qtpropertybrowser-uselib:!qtpropertybrowser-buildlib {
             $$PWD/qttreepropertybrowser.cpp \
             $$PWD/qtbuttonpropertybrowser.cpp \
             $$PWD/qtgroupboxpropertybrowser.cpp \
+            $$PWD/qtobjectcontroller.cpp \
             $$PWD/qtpropertybrowserutils.cpp
     HEADERS += $$PWD/qtpropertybrowser.h \
             $$PWD/qtpropertymanager.h \
@@ -20,6 +21,7 @@ qtpropertybrowser-uselib:!qtpropertybrowser-buildlib {
             $$PWD/qttreepropertybrowser.h \
             $$PWD/qtbuttonpropertybrowser.h \
             $$PWD/qtgroupboxpropertybrowser.h \
+            $$PWD/qtobjectcontroller.h \
             $$PWD/qtpropertybrowserutils_p.h
     RESOURCES += $$PWD/qtpropertybrowser.qrc
 }
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qtpropertybrowserutils_p.h"
+#include "qtpropertybrowser.h"
 #include <QtWidgets/QApplication>
 #include <QtGui/QPainter>
 #include <QtWidgets/QHBoxLayout>
@@ -46,6 +47,14 @@
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QMenu>
 #include <QtCore/QLocale>
+#include <QtCore/QTimer>
+#include <QtGui/QPaintEvent>
+#include <QtWidgets/QStyle>
+#include <QtWidgets/QStyleOption>
+#include <QtWidgets/QToolTip>
+#include <QtWidgets/qdrawutil.h>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
@@ -303,4 +312,581 @@ void QtBoolEdit::mousePressEvent(QMouseEvent *event)
     }
 }
 
+// QtPropertyRowView
+
+QtPropertyRowView::QtPropertyRowView(QtAbstractPropertyBrowser *browser, GroupStyle groupStyle, QWidget *parent) :
+    QWidget(parent),
+    m_browser(browser),
+    m_groupStyle(groupStyle),
+    m_dirty(true),
+    m_layoutPending(false),
+    m_currentItem(0),
+    m_editorItem(0),
+    m_editor(0),
+    m_rowHeight(0),
+    m_spacing(0),
+    m_margin(0),
+    m_valueLeft(0),
+    m_contentsHeight(0)
+{
+    setFocusPolicy(Qt::StrongFocus);
+    setSizePolicy(QSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed));
+}
+
+QtPropertyRowView::~QtPropertyRowView()
+{
+    if (m_editor)
+        disconnect(m_editor, SIGNAL(destroyed()), this, SLOT(slotEditorDestroyed()));
+}
+
+void QtPropertyRowView::itemInserted(QtBrowserItem *item)
+{
+    Q_UNUSED(item);
+    invalidate();
+}
+
+void QtPropertyRowView::itemRemoved(QtBrowserItem *item)
+{
+    for (QtBrowserItem *i = m_editorItem; i; i = i->parent()) {
+        if (i == item) {
+            closeEditor();
+            break;
+        }
+    }
+    if (m_currentItem == item)
+        m_currentItem = 0;
+    m_expanded.remove(item);
+    invalidate();
+}
+
+void QtPropertyRowView::itemChanged(QtBrowserItem *item)
+{
+    QtProperty *property = item->property();
+    if (item == m_editorItem) {
+        m_editor->setEnabled(property->isEnabled());
+        const QString valueToolTip = property->valueToolTip();
+        m_editor->setToolTip(valueToolTip.isEmpty() ? property->valueText() : valueToolTip);
+    }
+
+    const int index = m_itemToRow.value(item, -1);
+    if (m_dirty || index < 0) {
+        invalidate();
+        return;
+    }
+
+    // only a value changed, repaint the row without laying out again
+    const Row &row = m_rows.at(index);
+    if (row.name != property->propertyName() || row.hasValue != property->hasValue()
+            || row.enabled != property->isEnabled()) {
+        invalidate();
+        return;
+    }
+    update(rowRect(row));
+}
+
+bool QtPropertyRowView::isExpanded(QtBrowserItem *item) const
+{
+    return m_expanded.contains(item);
+}
+
+void QtPropertyRowView::setExpanded(QtBrowserItem *item, bool expanded)
+{
+    if (m_expanded.contains(item) == expanded)
+        return;
+    if (expanded)
+        m_expanded.insert(item);
+    else
+        m_expanded.remove(item);
+    if (m_groupStyle == ButtonGroups)
+        invalidate();
+}
+
+void QtPropertyRowView::toggleExpanded(QtBrowserItem *item)
+{
+    const bool expanded = !m_expanded.contains(item);
+    setExpanded(item, expanded);
+    expandedChanged(item, expanded);
+}
+
+void QtPropertyRowView::expandedChanged(QtBrowserItem *item, bool expanded)
+{
+    Q_UNUSED(item);
+    Q_UNUSED(expanded);
+}
+
+void QtPropertyRowView::setCurrentItem(QtBrowserItem *item)
+{
+    if (m_currentItem == item)
+        return;
+    if (m_editorItem != item)
+        closeEditor();
+    m_currentItem = item;
+    update();
+}
+
+QSize QtPropertyRowView::sizeHint() const
+{
+    const_cast<QtPropertyRowView *>(this)->layoutRows();
+    return QSize(m_valueLeft + fontMetrics().averageCharWidth() * 16, m_contentsHeight);
+}
+
+QSize QtPropertyRowView::minimumSizeHint() const
+{
+    return sizeHint();
+}
+
+void QtPropertyRowView::invalidate()
+{
+    m_dirty = true;
+    if (m_layoutPending)
+        return;
+    m_layoutPending = true;
+    QTimer::singleShot(0, this, SLOT(slotLayout()));
+}
+
+void QtPropertyRowView::slotLayout()
+{
+    m_layoutPending = false;
+    layoutRows();
+}
+
+void QtPropertyRowView::slotEditorDestroyed()
+{
+    if (sender() != m_editor)
+        return;
+    m_editor = 0;
+    m_editorItem = 0;
+    update();
+}
+
+// Computes the position of every row from the browser's items. This is
+// plain arithmetic, so its cost does not depend on any widget count.
+void QtPropertyRowView::layoutRows()
+{
+    if (!m_dirty)
+        return;
+    m_dirty = false;
+
+    if (!m_rowHeight) {
+        // one probe instead of an editor per row
+        QLineEdit probe;
+        probe.setFont(font());
+        m_rowHeight = probe.sizeHint().height();
+        m_spacing = style()->pixelMetric(QStyle::PM_LayoutVerticalSpacing, 0, this);
+        if (m_spacing < 0)
+            m_spacing = 6;
+        m_margin = style()->pixelMetric(QStyle::PM_LayoutLeftMargin, 0, this);
+        if (m_margin < 0)
+            m_margin = 9;
+    }
+
+    m_rows.clear();
+    m_itemToRow.clear();
+    int y = 0;
+    const QList<QtBrowserItem *> items = m_browser->topLevelItems();
+    for (QtBrowserItem *item : items)
+        y = appendRows(item, 0, y);
+    m_contentsHeight = qMax(0, y - m_spacing);
+
+    QFont labelFont = font();
+    labelFont.setUnderline(true);
+    const QFontMetrics labelMetrics(labelFont);
+    int labelRight = 0;
+    for (const Row &row : qAsConst(m_rows)) {
+        if (!row.group || m_groupStyle == ButtonGroups)
+            labelRight = qMax(labelRight, indent(row.depth) + labelMetrics.horizontalAdvance(row.name));
+    }
+    m_valueLeft = labelRight + m_spacing;
+
+    if (m_editor) {
+        const int index = m_itemToRow.value(m_editorItem, -1);
+        if (index < 0)
+            closeEditor();
+        else
+            m_editor->setGeometry(valueRect(m_rows.at(index)));
+    }
+    if (m_currentItem && !m_itemToRow.contains(m_currentItem))
+        m_currentItem = 0;
+
+    updateGeometry();
+    update();
+}
+
+int QtPropertyRowView::appendRows(QtBrowserItem *item, int depth, int y)
+{
+    QtProperty *property = item->property();
+    const QList<QtBrowserItem *> children = item->children();
+
+    Row row;
+    row.item = item;
+    row.name = property->propertyName();
+    row.depth = depth;
+    row.top = y;
+    row.groupBottom = -1;
+    row.group = !children.isEmpty();
+    row.hasValue = property->hasValue();
+    row.enabled = property->isEnabled();
+    if (row.group && m_groupStyle == GroupBoxGroups)
+        row.height = titleHeight() + (row.hasValue ? m_rowHeight + m_spacing : 0);
+    else
+        row.height = m_rowHeight;
+
+    const int index = m_rows.count();
+    m_rows.append(row);
+    m_itemToRow.insert(item, index);
+    y += row.height + m_spacing;
+
+    if (row.group && (m_groupStyle == GroupBoxGroups || m_expanded.contains(item))) {
+        y += m_margin;
+        for (QtBrowserItem *child : children)
+            y = appendRows(child, depth + 1, y);
+        y += m_margin - m_spacing;
+        m_rows[index].groupBottom = y;
+        y += m_spacing;
+    }
+    return y;
+}
+
+int QtPropertyRowView::rowAt(int y) const
+{
+    const auto it = std::lower_bound(m_rows.constBegin(), m_rows.constEnd(), y,
+                [](const Row &row, int pos) { return row.top + row.height <= pos; });
+    if (it == m_rows.constEnd() || it->top > y)
+        return -1;
+    return int(it - m_rows.constBegin());
+}
+
+int QtPropertyRowView::titleHeight() const
+{
+    return fontMetrics().height() + m_margin / 2;
+}
+
+QRect QtPropertyRowView::rowRect(const Row &row) const
+{
+    return QRect(0, row.top, width(), row.height);
+}
+
+QRect QtPropertyRowView::labelRect(const Row &row) const
+{
+    return QRect(indent(row.depth), row.top, m_valueLeft - m_spacing - indent(row.depth), row.height);
+}
+
+QRect QtPropertyRowView::valueRect(const Row &row) const
+{
+    if (row.group && m_groupStyle == GroupBoxGroups) {
+        // the header row of a group box spans both columns
+        const int left = indent(row.depth + 1);
+        return QRect(left, row.top + titleHeight(), right(row.depth + 1) - left + 1, m_rowHeight);
+    }
+    return QRect(m_valueLeft, row.top, right(row.depth) - m_valueLeft + 1, m_rowHeight);
+}
+
+QRect QtPropertyRowView::buttonRect(const Row &row) const
+{
+    const int buttonRight = row.hasValue ? m_valueLeft - m_spacing : right(row.depth);
+    return QRect(indent(row.depth), row.top, buttonRight - indent(row.depth) + 1, row.height);
+}
+
+bool QtPropertyRowView::event(QEvent *event)
+{
+    if (event->type() == QEvent::ToolTip) {
+        layoutRows();
+        QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+        const int index = rowAt(helpEvent->pos().y());
+        QString toolTip;
+        if (index >= 0) {
+            const Row &row = m_rows.at(index);
+            QtProperty *property = row.item->property();
+            if (row.hasValue && valueRect(row).contains(helpEvent->pos())) {
+                toolTip = property->valueToolTip();
+                if (toolTip.isEmpty())
+                    toolTip = property->valueText();
+            } else {
+                toolTip = property->descriptionToolTip();
+            }
+        }
+        if (toolTip.isEmpty())
+            QToolTip::hideText();
+        else
+            QToolTip::showText(helpEvent->globalPos(), toolTip, this);
+        return true;
+    }
+    return QWidget::event(event);
+}
+
+void QtPropertyRowView::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::StyleChange || event->type() == QEvent::FontChange) {
+        m_rowHeight = 0;
+        invalidate();
+    }
+    QWidget::changeEvent(event);
+}
+
+void QtPropertyRowView::paintEvent(QPaintEvent *event)
+{
+    layoutRows();
+    if (m_rows.isEmpty())
+        return;
+
+    QPainter painter(this);
+    const QRect exposed = event->rect();
+
+    const auto first = std::lower_bound(m_rows.constBegin(), m_rows.constEnd(), exposed.top(),
+                [](const Row &row, int pos) { return row.top + row.height <= pos; });
+
+    // frames of the groups enclosing the first exposed row start above it
+    if (first != m_rows.constEnd()) {
+        QList<int> enclosing;
+        for (QtBrowserItem *parent = first->item->parent(); parent; parent = parent->parent())
+            enclosing.prepend(m_itemToRow.value(parent));
+        for (int index : qAsConst(enclosing))
+            paintGroup(&painter, m_rows.at(index));
+    }
+
+    for (auto it = first; it != m_rows.constEnd() && it->top <= exposed.bottom(); ++it) {
+        if (it->group)
+            paintGroup(&painter, *it);
+        paintRow(&painter, *it);
+    }
+}
+
+void QtPropertyRowView::paintGroup(QPainter *painter, const Row &row)
+{
+    QtProperty *property = row.item->property();
+    QFont groupFont = font();
+    groupFont.setUnderline(property->isModified());
+
+    if (m_groupStyle == GroupBoxGroups) {
+        QStyleOptionGroupBox option;
+        option.initFrom(this);
+        option.rect = QRect(indent(row.depth), row.top, right(row.depth) - indent(row.depth) + 1,
+                    row.groupBottom - row.top);
+        option.text = row.name;
+        option.textAlignment = Qt::AlignLeft;
+        option.lineWidth = 1;
+        option.midLineWidth = 0;
+        option.subControls = QStyle::SC_GroupBoxFrame | QStyle::SC_GroupBoxLabel;
+        option.activeSubControls = QStyle::SC_None;
+        option.textColor = QColor(style()->styleHint(QStyle::SH_GroupBox_TextLabelColor, &option, this));
+        if (!row.enabled)
+            option.state &= ~QStyle::State_Enabled;
+        painter->save();
+        painter->setFont(groupFont);
+        style()->drawComplexControl(QStyle::CC_GroupBox, &option, painter, this);
+        painter->restore();
+        if (row.hasValue) {
+            const QRect value = valueRect(row);
+            const int y = value.bottom() + m_spacing / 2;
+            qDrawShadeLine(painter, value.left(), y, value.right(), y, palette(), true, 1, 0);
+        }
+        return;
+    }
+
+    const bool expanded = m_expanded.contains(row.item);
+    QStyleOptionToolButton option;
+    option.initFrom(this);
+    option.rect = buttonRect(row);
+    option.text = row.name;
+    option.font = groupFont;
+    option.arrowType = expanded ? Qt::UpArrow : Qt::DownArrow;
+    option.features = QStyleOptionToolButton::Arrow;
+    option.toolButtonStyle = Qt::ToolButtonTextBesideIcon;
+    option.iconSize = QSize(3, 16);
+    option.subControls = QStyle::SC_ToolButton;
+    if (expanded)
+        option.state |= QStyle::State_On | QStyle::State_Sunken;
+    else
+        option.state |= QStyle::State_Raised;
+    option.state &= ~QStyle::State_HasFocus;
+    if (!row.enabled)
+        option.state &= ~QStyle::State_Enabled;
+    painter->save();
+    painter->setFont(groupFont);
+    style()->drawComplexControl(QStyle::CC_ToolButton, &option, painter, this);
+    painter->restore();
+
+    if (row.groupBottom >= 0) {
+        const int top = row.top + row.height + m_spacing;
+        qDrawShadePanel(painter, QRect(indent(row.depth), top, right(row.depth) - indent(row.depth) + 1,
+                    row.groupBottom - top), palette(), false, 1);
+    }
+}
+
+void QtPropertyRowView::paintRow(QPainter *painter, const Row &row)
+{
+    if (!row.group) {
+        QFont labelFont = font();
+        labelFont.setUnderline(row.item->property()->isModified());
+        const QRect rect = labelRect(row);
+        painter->save();
+        painter->setFont(labelFont);
+        style()->drawItemText(painter, rect, Qt::AlignLeft | Qt::AlignVCenter, palette(), row.enabled,
+                    row.name, QPalette::WindowText);
+        painter->restore();
+    }
+
+    if (row.hasValue && row.item != m_editorItem)
+        paintValue(painter, row, valueRect(row));
+
+    if (row.item == m_currentItem && !m_editorItem && hasFocus()) {
+        QStyleOptionFocusRect option;
+        option.initFrom(this);
+        option.rect = row.group ? rowRect(row) : labelRect(row);
+        option.backgroundColor = palette().color(QPalette::Window);
+        style()->drawPrimitive(QStyle::PE_FrameFocusRect, &option, painter, this);
+    }
+}
+
+void QtPropertyRowView::paintValue(QPainter *painter, const Row &row, const QRect &rect)
+{
+    QtProperty *property = row.item->property();
+    QRect textRect = rect;
+    if (isEditable(property)) {
+        // editable values look like the line edit that replaces them on click
+        QStyleOptionFrame option;
+        option.initFrom(this);
+        option.rect = rect;
+        option.lineWidth = style()->pixelMetric(QStyle::PM_DefaultFrameWidth, &option, this);
+        option.midLineWidth = 0;
+        option.state |= QStyle::State_Sunken;
+        option.state &= ~QStyle::State_HasFocus;
+        if (!row.enabled)
+            option.state &= ~QStyle::State_Enabled;
+        style()->drawPrimitive(QStyle::PE_PanelLineEdit, &option, painter, this);
+        textRect = style()->subElementRect(QStyle::SE_LineEditContents, &option, this).adjusted(2, 0, -2, 0);
+    }
+
+    const QIcon icon = property->valueIcon();
+    if (!icon.isNull()) {
+        const int size = style()->pixelMetric(QStyle::PM_SmallIconSize, 0, this);
+        const QRect iconRect(textRect.left(), textRect.top() + (textRect.height() - size) / 2, size, size);
+        icon.paint(painter, iconRect, Qt::AlignCenter, row.enabled ? QIcon::Normal : QIcon::Disabled);
+        textRect.setLeft(iconRect.right() + 4);
+    }
+
+    const QString text = fontMetrics().elidedText(property->valueText(), Qt::ElideRight, textRect.width());
+    style()->drawItemText(painter, textRect, Qt::AlignLeft | Qt::AlignVCenter, palette(), row.enabled,
+                text, QPalette::Text);
+}
+
+void QtPropertyRowView::mousePressEvent(QMouseEvent *event)
+{
+    layoutRows();
+    const int index = rowAt(event->pos().y());
+    if (index < 0 || event->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    const Row &row = m_rows.at(index);
+    if (row.group && m_groupStyle == ButtonGroups && buttonRect(row).contains(event->pos())) {
+        if (row.enabled)
+            toggleExpanded(row.item);
+        event->accept();
+        return;
+    }
+
+    QtBrowserItem *item = row.item;
+    const bool onValue = row.hasValue && valueRect(row).contains(event->pos());
+    setCurrentItem(item);
+    if (onValue)
+        openEditor(item);
+    event->accept();
+}
+
+void QtPropertyRowView::keyPressEvent(QKeyEvent *event)
+{
+    layoutRows();
+    const int current = m_itemToRow.value(m_currentItem, -1);
+    switch (event->key()) {
+    case Qt::Key_Up:
+    case Qt::Key_Down: {
+        // rows with a value, and group buttons, which can be toggled
+        const int step = event->key() == Qt::Key_Up ? -1 : 1;
+        int index = current < 0 ? (step > 0 ? 0 : m_rows.count() - 1) : current + step;
+        for ( ; index >= 0 && index < m_rows.count(); index += step) {
+            const Row &row = m_rows.at(index);
+            if (row.hasValue || (row.group && m_groupStyle == ButtonGroups)) {
+                setCurrentItem(row.item);
+                break;
+            }
+        }
+        event->accept();
+        return;
+    }
+    case Qt::Key_Space:
+    case Qt::Key_Return:
+    case Qt::Key_Enter:
+        if (current >= 0 && m_rows.at(current).group && m_groupStyle == ButtonGroups) {
+            if (m_rows.at(current).enabled)
+                toggleExpanded(m_currentItem);
+            event->accept();
+            return;
+        }
+        if (event->key() == Qt::Key_Space)
+            break;
+        // fall through
+    case Qt::Key_F2:
+        if (m_currentItem) {
+            openEditor(m_currentItem);
+            event->accept();
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    QWidget::keyPressEvent(event);
+}
+
+void QtPropertyRowView::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    const int index = m_itemToRow.value(m_editorItem, -1);
+    if (m_editor && !m_dirty && index >= 0)
+        m_editor->setGeometry(valueRect(m_rows.at(index)));
+}
+
+void QtPropertyRowView::openEditor(QtBrowserItem *item)
+{
+    if (m_editor && m_editorItem == item) {
+        m_editor->setFocus();
+        return;
+    }
+    closeEditor();
+
+    const int index = m_itemToRow.value(item, -1);
+    QtProperty *property = item->property();
+    if (index < 0 || !property->isEnabled())
+        return;
+
+    QWidget *editor = createEditor(property, this);
+    if (!editor)
+        return;
+
+    m_editor = editor;
+    m_editorItem = item;
+    connect(editor, SIGNAL(destroyed()), this, SLOT(slotEditorDestroyed()));
+    const QString valueToolTip = property->valueToolTip();
+    editor->setToolTip(valueToolTip.isEmpty() ? property->valueText() : valueToolTip);
+    editor->setGeometry(valueRect(m_rows.at(index)));
+    editor->show();
+    editor->setFocus();
+    update(rowRect(m_rows.at(index)));
+}
+
+void QtPropertyRowView::closeEditor()
+{
+    if (!m_editor)
+        return;
+    QWidget *editor = m_editor;
+    m_editor = 0;
+    m_editorItem = 0;
+    disconnect(editor, SIGNAL(destroyed()), this, SLOT(slotEditorDestroyed()));
+    editor->hide();
+    editor->deleteLater();
+    update();
+}
+
 QT_END_NAMESPACE
@@ -55,12 +55,31 @@
 #include <QtGui/QIcon>
 #include <QtWidgets/QWidget>
 #include <QtCore/QStringList>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
 
 QT_BEGIN_NAMESPACE
 
 class QMouseEvent;
 class QCheckBox;
 class QLineEdit;
+class QtAbstractPropertyBrowser;
+class QtBrowserItem;
+class QtProperty;
+
+// Returns true if all values in the contiguous range [first, last) compare equal.
+template <class Value>
+bool qtIsUniform(const Value *first, const Value *last)
+{
+    if (first == last)
+        return true;
+    for (const Value *it = first + 1; it != last; ++it) {
+        if (!(*it == *first))
+            return false;
+    }
+    return true;
+}
 
 class QtCursorDatabase
 {
@@ -125,6 +144,100 @@ private:
     bool m_textVisible;
 };
 
+// Paints the rows of a QtGroupBoxPropertyBrowser or QtButtonPropertyBrowser
+// instead of holding label and editor widgets for each of them. Only the
+// current row gets a real editor, created through createEditor().
+class QtPropertyRowView : public QWidget
+{
+    Q_OBJECT
+public:
+    enum GroupStyle
+    {
+        GroupBoxGroups,
+        ButtonGroups
+    };
+
+    QtPropertyRowView(QtAbstractPropertyBrowser *browser, GroupStyle groupStyle, QWidget *parent = 0);
+    ~QtPropertyRowView();
+
+    void itemInserted(QtBrowserItem *item);
+    void itemRemoved(QtBrowserItem *item);
+    void itemChanged(QtBrowserItem *item);
+
+    bool isExpanded(QtBrowserItem *item) const;
+    void setExpanded(QtBrowserItem *item, bool expanded);
+
+    QtBrowserItem *currentItem() const { return m_currentItem; }
+    void setCurrentItem(QtBrowserItem *item);
+
+    QSize sizeHint() const;
+    QSize minimumSizeHint() const;
+
+protected:
+    virtual QWidget *createEditor(QtProperty *property, QWidget *parent) = 0;
+    virtual bool isEditable(QtProperty *property) const = 0;
+    virtual void expandedChanged(QtBrowserItem *item, bool expanded);
+
+    bool event(QEvent *event);
+    void changeEvent(QEvent *event);
+    void paintEvent(QPaintEvent *event);
+    void mousePressEvent(QMouseEvent *event);
+    void keyPressEvent(QKeyEvent *event);
+    void resizeEvent(QResizeEvent *event);
+
+private Q_SLOTS:
+    void slotLayout();
+    void slotEditorDestroyed();
+
+private:
+    struct Row
+    {
+        QtBrowserItem *item;
+        QString name;
+        int depth;
+        int top;
+        int height;
+        int groupBottom; // bottom of the group frame, -1 if the row is no (open) group
+        bool group;
+        bool hasValue;
+        bool enabled;
+    };
+
+    void invalidate();
+    void layoutRows();
+    int appendRows(QtBrowserItem *item, int depth, int y);
+    int rowAt(int y) const;
+    int indent(int depth) const { return depth * m_margin; }
+    int right(int depth) const { return width() - 1 - depth * m_margin; }
+    int titleHeight() const;
+    QRect rowRect(const Row &row) const;
+    QRect labelRect(const Row &row) const;
+    QRect valueRect(const Row &row) const;
+    QRect buttonRect(const Row &row) const;
+    void paintGroup(QPainter *painter, const Row &row);
+    void paintRow(QPainter *painter, const Row &row);
+    void paintValue(QPainter *painter, const Row &row, const QRect &rect);
+    void openEditor(QtBrowserItem *item);
+    void closeEditor();
+    void toggleExpanded(QtBrowserItem *item);
+
+    QtAbstractPropertyBrowser *m_browser;
+    GroupStyle m_groupStyle;
+    QVector<Row> m_rows;
+    QHash<QtBrowserItem *, int> m_itemToRow;
+    QSet<QtBrowserItem *> m_expanded;
+    bool m_dirty;
+    bool m_layoutPending;
+    QtBrowserItem *m_currentItem;
+    QtBrowserItem *m_editorItem;
+    QWidget *m_editor;
+    int m_rowHeight;
+    int m_spacing;
+    int m_margin;
+    int m_valueLeft;
+    int m_contentsHeight;
+};
+
 QT_END_NAMESPACE
 
 #endif
@@ -42,9 +42,16 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QLocale>
 #include <QtCore/QMap>
+#include <QtCore/QVector>
 #include <QtCore/QTimer>
 #include <QtGui/QIcon>
 #include <QtCore/QMetaEnum>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QBitArray>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedData>
 #include <QtGui/QFontDatabase>
 #include <QtWidgets/QStyleOption>
 #include <QtWidgets/QStyle>
@@ -52,6 +59,7 @@
 #include <QtGui/QPainter>
 #include <QtWidgets/QLabel>
 
+#include <algorithm>
 #include <limits>
 #include <limits.h>
 #include <float.h>
@@ -231,7 +239,7 @@ static void setSimpleValue(QMap<const QtProperty *, Value> &propertyMap,
 
     it.value() = val;
 
-    emit (manager->*propertyChangedSignal)(property);
+    (manager->*propertyChangedSignal)(property);
     emit (manager->*valueChangedSignal)(property, val);
 }
 
@@ -261,7 +269,7 @@ static void setValueInRange(PropertyManager *manager, PropertyManagerPrivate *ma
     if (setSubPropertyValue)
         (managerPrivate->*setSubPropertyValue)(property, data.val);
 
-    emit (manager->*propertyChangedSignal)(property);
+    (manager->*propertyChangedSignal)(property);
     emit (manager->*valueChangedSignal)(property, data.val);
 }
 
@@ -300,7 +308,7 @@ static void setBorderValues(PropertyManager *manager, PropertyManagerPrivate *ma
     if (data.val == oldVal)
         return;
 
-    emit (manager->*propertyChangedSignal)(property);
+    (manager->*propertyChangedSignal)(property);
     emit (manager->*valueChangedSignal)(property, data.val);
 }
 
@@ -336,7 +344,7 @@ static void setBorderValue(PropertyManager *manager, PropertyManagerPrivate *man
     if (data.val == oldVal)
         return;
 
-    emit (manager->*propertyChangedSignal)(property);
+    (manager->*propertyChangedSignal)(property);
     emit (manager->*valueChangedSignal)(property, data.val);
 }
 
@@ -378,83 +386,24 @@ private:
     QtMetaEnumWrapper(QObject *parent) : QObject(parent) {}
 };
 
-class QtMetaEnumProvider
+// Size policy names, read from the QSizePolicy::Policy meta enum.
+
+class QtSizePolicyEnumProvider
 {
 public:
-    QtMetaEnumProvider();
+    QtSizePolicyEnumProvider();
 
     QStringList policyEnumNames() const { return m_policyEnumNames; }
-    QStringList languageEnumNames() const { return m_languageEnumNames; }
-    QStringList countryEnumNames(QLocale::Language language) const { return m_countryEnumNames.value(language); }
 
     QSizePolicy::Policy indexToSizePolicy(int index) const;
     int sizePolicyToIndex(QSizePolicy::Policy policy) const;
 
-    void indexToLocale(int languageIndex, int countryIndex, QLocale::Language *language, QLocale::Country *country) const;
-    void localeToIndex(QLocale::Language language, QLocale::Country country, int *languageIndex, int *countryIndex) const;
-
 private:
-    void initLocale();
-
     QStringList m_policyEnumNames;
-    QStringList m_languageEnumNames;
-    QMap<QLocale::Language, QStringList> m_countryEnumNames;
-    QMap<int, QLocale::Language> m_indexToLanguage;
-    QMap<QLocale::Language, int> m_languageToIndex;
-    QMap<int, QMap<int, QLocale::Country> > m_indexToCountry;
-    QMap<QLocale::Language, QMap<QLocale::Country, int> > m_countryToIndex;
     QMetaEnum m_policyEnum;
 };
 
-static QList<QLocale::Country> sortCountries(const QList<QLocale::Country> &countries)
-{
-    QMultiMap<QString, QLocale::Country> nameToCountry;
-    for (QLocale::Country country : countries)
-        nameToCountry.insert(QLocale::countryToString(country), country);
-    return nameToCountry.values();
-}
-
-void QtMetaEnumProvider::initLocale()
-{
-    QMultiMap<QString, QLocale::Language> nameToLanguage;
-    for (int l = QLocale::C, last = QLocale::LastLanguage; l <= last; ++l) {
-        const QLocale::Language language = static_cast<QLocale::Language>(l);
-        QLocale locale(language);
-        if (locale.language() == language)
-            nameToLanguage.insert(QLocale::languageToString(language), language);
-    }
-
-    const QLocale system = QLocale::system();
-    if (!nameToLanguage.contains(QLocale::languageToString(system.language())))
-        nameToLanguage.insert(QLocale::languageToString(system.language()), system.language());
-
-    const auto languages = nameToLanguage.values();
-    for (QLocale::Language language : languages) {
-        QList<QLocale::Country> countries;
-        countries = QLocale::countriesForLanguage(language);
-        if (countries.isEmpty() && language == system.language())
-            countries << system.country();
-
-        if (!countries.isEmpty() && !m_languageToIndex.contains(language)) {
-            countries = sortCountries(countries);
-            int langIdx = m_languageEnumNames.count();
-            m_indexToLanguage[langIdx] = language;
-            m_languageToIndex[language] = langIdx;
-            QStringList countryNames;
-            int countryIdx = 0;
-            for (QLocale::Country country : qAsConst(countries)) {
-                countryNames << QLocale::countryToString(country);
-                m_indexToCountry[langIdx][countryIdx] = country;
-                m_countryToIndex[language][country] = countryIdx;
-                ++countryIdx;
-            }
-            m_languageEnumNames << QLocale::languageToString(language);
-            m_countryEnumNames[language] = countryNames;
-        }
-    }
-}
-
-QtMetaEnumProvider::QtMetaEnumProvider()
+QtSizePolicyEnumProvider::QtSizePolicyEnumProvider()
 {
     QMetaProperty p;
 
@@ -464,16 +413,14 @@ QtMetaEnumProvider::QtMetaEnumProvider()
     const int keyCount = m_policyEnum.keyCount();
     for (int i = 0; i < keyCount; i++)
         m_policyEnumNames << QLatin1String(m_policyEnum.key(i));
-
-    initLocale();
 }
 
-QSizePolicy::Policy QtMetaEnumProvider::indexToSizePolicy(int index) const
+QSizePolicy::Policy QtSizePolicyEnumProvider::indexToSizePolicy(int index) const
 {
     return static_cast<QSizePolicy::Policy>(m_policyEnum.value(index));
 }
 
-int QtMetaEnumProvider::sizePolicyToIndex(QSizePolicy::Policy policy) const
+int QtSizePolicyEnumProvider::sizePolicyToIndex(QSizePolicy::Policy policy) const
 {
      const int keyCount = m_policyEnum.keyCount();
     for (int i = 0; i < keyCount; i++)
@@ -482,14 +429,127 @@ int QtMetaEnumProvider::sizePolicyToIndex(QSizePolicy::Policy policy) const
     return -1;
 }
 
-void QtMetaEnumProvider::indexToLocale(int languageIndex, int countryIndex, QLocale::Language *language, QLocale::Country *country) const
+Q_GLOBAL_STATIC(QtSizePolicyEnumProvider, sizePolicyEnumProvider)
+
+// Language and country names of the locale database. Building them walks
+// the whole database, so they are kept apart from the size policy names and
+// only built once a locale property is used. Languages are sorted by name;
+// the tables are flat arrays indexed by the language index shown in the
+// language enum.
+
+class QtLocaleEnumProvider
+{
+public:
+    QtLocaleEnumProvider();
+
+    QStringList languageEnumNames() const { return m_languageEnumNames; }
+    QStringList countryEnumNames(QLocale::Language language) const;
+
+    void indexToLocale(int languageIndex, int countryIndex, QLocale::Language *language, QLocale::Country *country) const;
+    void localeToIndex(QLocale::Language language, QLocale::Country country, int *languageIndex, int *countryIndex) const;
+
+private:
+    struct LanguageEntry
+    {
+        QLocale::Language language;
+        int index;
+    };
+
+    static bool languageLessThan(const LanguageEntry &entry, QLocale::Language language)
+    { return entry.language < language; }
+
+    int languageToIndex(QLocale::Language language) const;
+
+    QStringList m_languageEnumNames;
+    QVector<QLocale::Language> m_indexToLanguage;
+    QVector<LanguageEntry> m_languageToIndex; // sorted by language
+    QVector<QStringList> m_countryEnumNames;
+    QVector<QVector<QLocale::Country> > m_indexToCountry;
+};
+
+QtLocaleEnumProvider::QtLocaleEnumProvider()
+{
+    // One pass over the locale database instead of a QLocale and a
+    // countriesForLanguage() call per language.
+    QMap<QLocale::Language, QVector<QLocale::Country> > languageToCountries;
+    const QList<QLocale> locales = QLocale::matchingLocales(QLocale::AnyLanguage, QLocale::AnyScript, QLocale::AnyCountry);
+    for (const QLocale &locale : locales) {
+        QVector<QLocale::Country> &countries = languageToCountries[locale.language()];
+        if (!countries.contains(locale.country()))
+            countries.append(locale.country());
+    }
+
+    QVector<QLocale::Country> cCountries;
+    cCountries.append(QLocale::AnyCountry);
+    languageToCountries[QLocale::C] = cCountries;
+
+    const QLocale system = QLocale::system();
+    QVector<QLocale::Country> &systemCountries = languageToCountries[system.language()];
+    if (systemCountries.isEmpty())
+        systemCountries.append(system.country());
+
+    QVector<QPair<QString, QLocale::Language> > languages;
+    languages.reserve(languageToCountries.count());
+    for (auto it = languageToCountries.cbegin(), end = languageToCountries.cend(); it != end; ++it)
+        languages.append(qMakePair(QLocale::languageToString(it.key()), it.key()));
+    std::sort(languages.begin(), languages.end());
+
+    m_indexToLanguage.reserve(languages.count());
+    m_languageToIndex.reserve(languages.count());
+    m_countryEnumNames.reserve(languages.count());
+    m_indexToCountry.reserve(languages.count());
+    for (const auto &language : qAsConst(languages)) {
+        const QVector<QLocale::Country> countries = languageToCountries.value(language.second);
+        QVector<QPair<QString, QLocale::Country> > sortedCountries;
+        sortedCountries.reserve(countries.count());
+        for (QLocale::Country country : countries)
+            sortedCountries.append(qMakePair(QLocale::countryToString(country), country));
+        std::sort(sortedCountries.begin(), sortedCountries.end());
+
+        QStringList countryNames;
+        QVector<QLocale::Country> indexToCountry;
+        indexToCountry.reserve(sortedCountries.count());
+        for (const auto &country : qAsConst(sortedCountries)) {
+            countryNames << country.first;
+            indexToCountry.append(country.second);
+        }
+
+        const LanguageEntry entry = { language.second, m_indexToLanguage.count() };
+        m_languageToIndex.append(entry);
+        m_indexToLanguage.append(language.second);
+        m_languageEnumNames << language.first;
+        m_countryEnumNames.append(countryNames);
+        m_indexToCountry.append(indexToCountry);
+    }
+    std::sort(m_languageToIndex.begin(), m_languageToIndex.end(),
+              [](const LanguageEntry &a, const LanguageEntry &b) { return a.language < b.language; });
+}
+
+int QtLocaleEnumProvider::languageToIndex(QLocale::Language language) const
+{
+    const auto it = std::lower_bound(m_languageToIndex.cbegin(), m_languageToIndex.cend(), language, languageLessThan);
+    if (it == m_languageToIndex.cend() || it->language != language)
+        return -1;
+    return it->index;
+}
+
+QStringList QtLocaleEnumProvider::countryEnumNames(QLocale::Language language) const
+{
+    const int languageIndex = languageToIndex(language);
+    if (languageIndex < 0)
+        return QStringList();
+    return m_countryEnumNames.at(languageIndex);
+}
+
+void QtLocaleEnumProvider::indexToLocale(int languageIndex, int countryIndex, QLocale::Language *language, QLocale::Country *country) const
 {
     QLocale::Language l = QLocale::C;
     QLocale::Country c = QLocale::AnyCountry;
-    if (m_indexToLanguage.contains(languageIndex)) {
-        l = m_indexToLanguage[languageIndex];
-        if (m_indexToCountry.contains(languageIndex) && m_indexToCountry[languageIndex].contains(countryIndex))
-            c = m_indexToCountry[languageIndex][countryIndex];
+    if (languageIndex >= 0 && languageIndex < m_indexToLanguage.count()) {
+        l = m_indexToLanguage.at(languageIndex);
+        const QVector<QLocale::Country> &countries = m_indexToCountry.at(languageIndex);
+        if (countryIndex >= 0 && countryIndex < countries.count())
+            c = countries.at(countryIndex);
     }
     if (language)
         *language = l;
@@ -497,15 +557,10 @@ void QtMetaEnumProvider::indexToLocale(int languageIndex, int countryIndex, QLoc
         *country = c;
 }
 
-void QtMetaEnumProvider::localeToIndex(QLocale::Language language, QLocale::Country country, int *languageIndex, int *countryIndex) const
+void QtLocaleEnumProvider::localeToIndex(QLocale::Language language, QLocale::Country country, int *languageIndex, int *countryIndex) const
 {
-    int l = -1;
-    int c = -1;
-    if (m_languageToIndex.contains(language)) {
-        l = m_languageToIndex[language];
-        if (m_countryToIndex.contains(language) && m_countryToIndex[language].contains(country))
-            c = m_countryToIndex[language][country];
-    }
+    const int l = languageToIndex(language);
+    const int c = l >= 0 ? m_indexToCountry.at(l).indexOf(country) : -1;
 
     if (languageIndex)
         *languageIndex = l;
@@ -513,7 +568,7 @@ void QtMetaEnumProvider::localeToIndex(QLocale::Language language, QLocale::Coun
         *countryIndex = c;
 }
 
-Q_GLOBAL_STATIC(QtMetaEnumProvider, metaEnumProvider)
+Q_GLOBAL_STATIC(QtLocaleEnumProvider, localeEnumProvider)
 
 // QtGroupPropertyManager
 
@@ -739,7 +794,7 @@ void QtIntPropertyManager::setValue(QtProperty *property, int val)
 {
     void (QtIntPropertyManagerPrivate::*setSubPropertyValue)(QtProperty *, int) = 0;
     setValueInRange<int, QtIntPropertyManagerPrivate, QtIntPropertyManager, int>(this, d_ptr.data(),
-                &QtIntPropertyManager::propertyChanged,
+                &QtIntPropertyManager::notifyPropertyChanged,
                 &QtIntPropertyManager::valueChanged,
                 property, val, setSubPropertyValue);
 }
@@ -756,7 +811,7 @@ void QtIntPropertyManager::setValue(QtProperty *property, int val)
 void QtIntPropertyManager::setMinimum(QtProperty *property, int minVal)
 {
     setMinimumValue<int, QtIntPropertyManagerPrivate, QtIntPropertyManager, int, QtIntPropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtIntPropertyManager::propertyChanged,
+                &QtIntPropertyManager::notifyPropertyChanged,
                 &QtIntPropertyManager::valueChanged,
                 &QtIntPropertyManager::rangeChanged,
                 property, minVal);
@@ -774,7 +829,7 @@ void QtIntPropertyManager::setMinimum(QtProperty *property, int minVal)
 void QtIntPropertyManager::setMaximum(QtProperty *property, int maxVal)
 {
     setMaximumValue<int, QtIntPropertyManagerPrivate, QtIntPropertyManager, int, QtIntPropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtIntPropertyManager::propertyChanged,
+                &QtIntPropertyManager::notifyPropertyChanged,
                 &QtIntPropertyManager::valueChanged,
                 &QtIntPropertyManager::rangeChanged,
                 property, maxVal);
@@ -798,7 +853,7 @@ void QtIntPropertyManager::setRange(QtProperty *property, int minVal, int maxVal
 {
     void (QtIntPropertyManagerPrivate::*setSubPropertyRange)(QtProperty *, int, int, int) = 0;
     setBorderValues<int, QtIntPropertyManagerPrivate, QtIntPropertyManager, int>(this, d_ptr.data(),
-                &QtIntPropertyManager::propertyChanged,
+                &QtIntPropertyManager::notifyPropertyChanged,
                 &QtIntPropertyManager::valueChanged,
                 &QtIntPropertyManager::rangeChanged,
                 property, minVal, maxVal, setSubPropertyRange);
@@ -1037,7 +1092,7 @@ void QtDoublePropertyManager::setValue(QtProperty *property, double val)
 {
     void (QtDoublePropertyManagerPrivate::*setSubPropertyValue)(QtProperty *, double) = 0;
     setValueInRange<double, QtDoublePropertyManagerPrivate, QtDoublePropertyManager, double>(this, d_ptr.data(),
-                &QtDoublePropertyManager::propertyChanged,
+                &QtDoublePropertyManager::notifyPropertyChanged,
                 &QtDoublePropertyManager::valueChanged,
                 property, val, setSubPropertyValue);
 }
@@ -1114,7 +1169,7 @@ void QtDoublePropertyManager::setDecimals(QtProperty *property, int prec)
 void QtDoublePropertyManager::setMinimum(QtProperty *property, double minVal)
 {
     setMinimumValue<double, QtDoublePropertyManagerPrivate, QtDoublePropertyManager, double, QtDoublePropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtDoublePropertyManager::propertyChanged,
+                &QtDoublePropertyManager::notifyPropertyChanged,
                 &QtDoublePropertyManager::valueChanged,
                 &QtDoublePropertyManager::rangeChanged,
                 property, minVal);
@@ -1132,7 +1187,7 @@ void QtDoublePropertyManager::setMinimum(QtProperty *property, double minVal)
 void QtDoublePropertyManager::setMaximum(QtProperty *property, double maxVal)
 {
     setMaximumValue<double, QtDoublePropertyManagerPrivate, QtDoublePropertyManager, double, QtDoublePropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtDoublePropertyManager::propertyChanged,
+                &QtDoublePropertyManager::notifyPropertyChanged,
                 &QtDoublePropertyManager::valueChanged,
                 &QtDoublePropertyManager::rangeChanged,
                 property, maxVal);
@@ -1156,7 +1211,7 @@ void QtDoublePropertyManager::setRange(QtProperty *property, double minVal, doub
 {
     void (QtDoublePropertyManagerPrivate::*setSubPropertyRange)(QtProperty *, double, double, double) = 0;
     setBorderValues<double, QtDoublePropertyManagerPrivate, QtDoublePropertyManager, double>(this, d_ptr.data(),
-                &QtDoublePropertyManager::propertyChanged,
+                &QtDoublePropertyManager::notifyPropertyChanged,
                 &QtDoublePropertyManager::valueChanged,
                 &QtDoublePropertyManager::rangeChanged,
                 property, minVal, maxVal, setSubPropertyRange);
@@ -1178,6 +1233,173 @@ void QtDoublePropertyManager::uninitializeProperty(QtProperty *property)
     d_ptr->m_values.remove(property);
 }
 
+// Interned string constraints. Properties constrained by the same regular
+// expression share one QtStringConstraint holding the compiled, anchored
+// expression. Unconstrained properties, the default, have none at all.
+
+class QtStringConstraint : public QSharedData
+{
+public:
+    QRegExp regExp;                       // as reported by regExp()
+    QRegularExpression regularExpression; // as reported by regularExpression()
+    QRegularExpression matcher;           // anchored and optimized, used to validate values
+};
+
+typedef QExplicitlySharedDataPointer<QtStringConstraint> QtStringConstraintHandle;
+
+class QtStringConstraintRegistry
+{
+public:
+    QtStringConstraintHandle intern(const QRegularExpression &regularExpression, const QRegExp &regExp);
+
+private:
+    void purge();
+
+    QMutex m_mutex;
+    QHash<QRegularExpression, QtStringConstraintHandle> m_constraints;
+    int m_purgeThreshold{64};
+};
+
+Q_GLOBAL_STATIC(QtStringConstraintRegistry, stringConstraintRegistry)
+
+QtStringConstraintHandle QtStringConstraintRegistry::intern(const QRegularExpression &regularExpression,
+            const QRegExp &regExp)
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_constraints.constFind(regularExpression);
+    if (it != m_constraints.constEnd())
+        return it.value();
+
+    QtStringConstraintHandle constraint(new QtStringConstraint);
+    constraint->regExp = regExp;
+    constraint->regularExpression = regularExpression;
+    constraint->matcher = QRegularExpression(QRegularExpression::anchoredPattern(regularExpression.pattern()),
+                                             regularExpression.patternOptions());
+    constraint->matcher.optimize();
+    m_constraints.insert(regularExpression, constraint);
+    if (m_constraints.size() > m_purgeThreshold)
+        purge();
+    return constraint;
+}
+
+// Drops constraints no property refers to any more.
+void QtStringConstraintRegistry::purge()
+{
+    for (auto it = m_constraints.begin(); it != m_constraints.end(); ) {
+        if (it.value()->ref.loadAcquire() == 1)
+            it = m_constraints.erase(it);
+        else
+            ++it;
+    }
+    m_purgeThreshold = qMax(64, 2 * m_constraints.size());
+}
+
+static QtStringConstraintHandle internStringConstraint(const QRegularExpression &regularExpression,
+            const QRegExp &regExp)
+{
+    if (!regularExpression.isValid() || regularExpression.pattern().isEmpty())
+        return QtStringConstraintHandle();
+
+    if (QtStringConstraintRegistry *registry = stringConstraintRegistry())
+        return registry->intern(regularExpression, regExp);
+
+    QtStringConstraintHandle constraint(new QtStringConstraint);
+    constraint->regExp = regExp;
+    constraint->regularExpression = regularExpression;
+    constraint->matcher = QRegularExpression(QRegularExpression::anchoredPattern(regularExpression.pattern()),
+                                             regularExpression.patternOptions());
+    return constraint;
+}
+
+// Translates a QRegExp wildcard the way QRegExp itself does: '*' and '?'
+// also match '/', and "[...]" sets are kept ("[!...]" negates). Only
+// WildcardUnix escapes the wildcard characters with a backslash.
+static QString wildcardToPattern(const QString &wildcard, bool unixEscapes)
+{
+    QString pattern;
+    const int count = wildcard.size();
+    int i = 0;
+    while (i < count) {
+        const QChar c = wildcard.at(i++);
+        switch (c.unicode()) {
+        case '*':
+            pattern += QLatin1String(".*");
+            break;
+        case '?':
+            pattern += QLatin1Char('.');
+            break;
+        case '\\':
+            if (unixEscapes && i < count)
+                pattern += QRegularExpression::escape(wildcard.at(i++));
+            else
+                pattern += QLatin1String("\\\\");
+            break;
+        case '[': {
+            int end = i;
+            if (end < count && (wildcard.at(end) == QLatin1Char('!') || wildcard.at(end) == QLatin1Char('^')))
+                ++end;
+            if (end < count && wildcard.at(end) == QLatin1Char(']'))
+                ++end;
+            while (end < count && wildcard.at(end) != QLatin1Char(']'))
+                ++end;
+            if (end == count) {
+                pattern += QLatin1String("\\[");
+                break;
+            }
+            pattern += QLatin1Char('[');
+            if (wildcard.at(i) == QLatin1Char('!') || wildcard.at(i) == QLatin1Char('^')) {
+                pattern += QLatin1Char('^');
+                ++i;
+            }
+            for (; i < end; ++i) {
+                const QChar member = wildcard.at(i);
+                if (member == QLatin1Char('\\') || member == QLatin1Char('['))
+                    pattern += QLatin1Char('\\');
+                pattern += member;
+            }
+            pattern += QLatin1Char(']');
+            ++i;
+            break;
+        }
+        default:
+            pattern += QRegularExpression::escape(QString(c));
+            break;
+        }
+    }
+    return pattern;
+}
+
+static QRegularExpression toRegularExpression(const QRegExp &regExp)
+{
+    QString pattern;
+    switch (regExp.patternSyntax()) {
+    case QRegExp::Wildcard:
+    case QRegExp::WildcardUnix:
+        pattern = wildcardToPattern(regExp.pattern(), regExp.patternSyntax() == QRegExp::WildcardUnix);
+        break;
+    case QRegExp::FixedString:
+        pattern = QRegularExpression::escape(regExp.pattern());
+        break;
+    default:
+        pattern = regExp.pattern();
+        break;
+    }
+
+    QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption;
+    if (regExp.caseSensitivity() == Qt::CaseInsensitive)
+        options |= QRegularExpression::CaseInsensitiveOption;
+    if (regExp.isMinimal())
+        options |= QRegularExpression::InvertedGreedinessOption;
+    return QRegularExpression(pattern, options);
+}
+
+static inline bool isDefaultRegExp(const QRegExp &regExp)
+{
+    return !regExp.isValid() || regExp.isEmpty()
+        || ((regExp.patternSyntax() == QRegExp::Wildcard || regExp.patternSyntax() == QRegExp::WildcardUnix)
+            && regExp.pattern() == QString(QLatin1Char('*')));
+}
+
 // QtStringPropertyManager
 
 class QtStringPropertyManagerPrivate
@@ -1188,17 +1410,31 @@ public:
 
     struct Data
     {
-        Data() : regExp(QString(QLatin1Char('*')),  Qt::CaseSensitive, QRegExp::Wildcard)
-        {
-        }
         QString val;
-        QRegExp regExp;
+        QtStringConstraintHandle constraint; // null if the value is not constrained
     };
 
+    void setConstraint(QtProperty *property, const QtStringConstraintHandle &constraint);
+
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
     QMap<const QtProperty *, Data> m_values;
 };
 
+void QtStringPropertyManagerPrivate::setConstraint(QtProperty *property, const QtStringConstraintHandle &constraint)
+{
+    const PropertyValueMap::iterator it = m_values.find(property);
+    if (it == m_values.end())
+        return;
+
+    if (it.value().constraint == constraint)
+        return;
+
+    it.value().constraint = constraint;
+
+    emit q_ptr->regExpChanged(property, q_ptr->regExp(property));
+    emit q_ptr->regularExpressionChanged(property, q_ptr->regularExpression(property));
+}
+
 /*!
     \class QtStringPropertyManager
     \internal
@@ -1211,13 +1447,16 @@ public:
     function, and set using the setValue() slot.
 
     The current value can be checked against a regular expression. To
-    set the regular expression use the setRegExp() slot, use the
-    regExp() function to retrieve the currently set expression.
+    set the regular expression use the setRegularExpression() or
+    setRegExp() slot, use the regularExpression() or regExp() function
+    to retrieve the currently set expression. Properties constrained by
+    the same expression share one compiled copy of it.
 
     In addition, QtStringPropertyManager provides the valueChanged() signal
     which is emitted whenever a property created by this manager
-    changes, and the regExpChanged() signal which is emitted whenever
-    such a property changes its currently set regular expression.
+    changes, and the regularExpressionChanged() and regExpChanged()
+    signals which are emitted whenever such a property changes its
+    currently set regular expression.
 
     \sa QtAbstractPropertyManager, QtLineEditFactory
 */
@@ -1242,6 +1481,16 @@ public:
     \sa setRegExp()
 */
 
+/*!
+    \fn void QtStringPropertyManager::regularExpressionChanged(QtProperty *property, const QRegularExpression &regularExpression)
+
+    This signal is emitted whenever a property created by this manager
+    changes its currently set regular expression, passing a pointer to
+    the \a property and the new \a regularExpression as parameters.
+
+    \sa setRegularExpression()
+*/
+
 /*!
     Creates a manager with the given \a parent.
 */
@@ -1282,7 +1531,29 @@ QString QtStringPropertyManager::value(const QtProperty *property) const
 */
 QRegExp QtStringPropertyManager::regExp(const QtProperty *property) const
 {
-    return getData<QRegExp>(d_ptr->m_values, &QtStringPropertyManagerPrivate::Data::regExp, property, QRegExp());
+    const auto it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return QRegExp();
+    const QtStringConstraintHandle &constraint = it.value().constraint;
+    if (!constraint)
+        return QRegExp(QString(QLatin1Char('*')), Qt::CaseSensitive, QRegExp::Wildcard);
+    return constraint->regExp;
+}
+
+/*!
+    Returns the given \a property's currently set regular expression.
+
+    An empty expression is returned if the \a property's value is not
+    constrained, or if the \a property is not managed by this manager.
+
+    \sa setRegularExpression()
+*/
+QRegularExpression QtStringPropertyManager::regularExpression(const QtProperty *property) const
+{
+    const auto it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd() || !it.value().constraint)
+        return QRegularExpression();
+    return it.value().constraint->regularExpression;
 }
 
 /*!
@@ -1317,38 +1588,46 @@ void QtStringPropertyManager::setValue(QtProperty *property, const QString &val)
     if (data.val == val)
         return;
 
-    if (data.regExp.isValid() && !data.regExp.exactMatch(val))
+    if (data.constraint && !data.constraint->matcher.match(val).hasMatch())
         return;
 
     data.val = val;
 
     it.value() = data;
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, data.val);
 }
 
 /*!
     Sets the regular expression of the given \a property to \a regExp.
+    The expression is converted to a QRegularExpression; the default
+    wildcard \c{*} removes the constraint.
 
     \sa regExp(), setValue(), regExpChanged()
 */
 void QtStringPropertyManager::setRegExp(QtProperty *property, const QRegExp &regExp)
 {
-    const QtStringPropertyManagerPrivate::PropertyValueMap::iterator it = d_ptr->m_values.find(property);
-    if (it == d_ptr->m_values.end())
+    if (isDefaultRegExp(regExp)) {
+        d_ptr->setConstraint(property, QtStringConstraintHandle());
         return;
+    }
+    d_ptr->setConstraint(property, internStringConstraint(toRegularExpression(regExp), regExp));
+}
 
-    QtStringPropertyManagerPrivate::Data data = it.value() ;
-
-    if (data.regExp == regExp)
-        return;
-
-    data.regExp = regExp;
-
-    it.value() = data;
+/*!
+    Sets the regular expression of the given \a property to \a
+    regularExpression. The whole value has to match it. An empty or
+    invalid expression removes the constraint.
 
-    emit regExpChanged(property, data.regExp);
+    \sa regularExpression(), setValue(), regularExpressionChanged()
+*/
+void QtStringPropertyManager::setRegularExpression(QtProperty *property, const QRegularExpression &regularExpression)
+{
+    const QRegExp regExp(regularExpression.pattern(),
+                regularExpression.patternOptions() & QRegularExpression::CaseInsensitiveOption
+                    ? Qt::CaseInsensitive : Qt::CaseSensitive, QRegExp::RegExp2);
+    d_ptr->setConstraint(property, internStringConstraint(regularExpression, regExp));
 }
 
 /*!
@@ -1398,13 +1677,17 @@ static QIcon drawCheckBox(bool value)
     return QIcon(pixmap);
 }
 
-class QtBoolPropertyManagerPrivate
+class QtBoolPropertyManagerPrivate : public QtInlineEditing
 {
     QtBoolPropertyManager *q_ptr;
     Q_DECLARE_PUBLIC(QtBoolPropertyManager)
 public:
     QtBoolPropertyManagerPrivate();
 
+    ValueType inlineValueType(const QtProperty *) const { return BoolValue; }
+    QVariant inlineValue(const QtProperty *property) const { return m_values.value(property, false); }
+    void setInlineValue(QtProperty *property, const QVariant &value) { q_ptr->setValue(property, value.toBool()); }
+
     QMap<const QtProperty *, bool> m_values;
     const QIcon m_checkedIcon;
     const QIcon m_uncheckedIcon;
@@ -1472,6 +1755,14 @@ bool QtBoolPropertyManager::value(const QtProperty *property) const
     return d_ptr->m_values.value(property, false);
 }
 
+/*!
+    \reimp
+*/
+QtInlineEditing *QtBoolPropertyManager::inlineEditing() const
+{
+    return d_ptr.data();
+}
+
 /*!
     \reimp
 */
@@ -1508,7 +1799,7 @@ QIcon QtBoolPropertyManager::valueIcon(const QtProperty *property) const
 void QtBoolPropertyManager::setValue(QtProperty *property, bool val)
 {
     setSimpleValue<bool, bool, QtBoolPropertyManager>(d_ptr->m_values, this,
-                &QtBoolPropertyManager::propertyChanged,
+                &QtBoolPropertyManager::notifyPropertyChanged,
                 &QtBoolPropertyManager::valueChanged,
                 property, val);
 }
@@ -1681,7 +1972,7 @@ void QtDatePropertyManager::setValue(QtProperty *property, const QDate &val)
 {
     void (QtDatePropertyManagerPrivate::*setSubPropertyValue)(QtProperty *, const QDate &) = 0;
     setValueInRange<const QDate &, QtDatePropertyManagerPrivate, QtDatePropertyManager, const QDate>(this, d_ptr.data(),
-                &QtDatePropertyManager::propertyChanged,
+                &QtDatePropertyManager::notifyPropertyChanged,
                 &QtDatePropertyManager::valueChanged,
                 property, val, setSubPropertyValue);
 }
@@ -1698,7 +1989,7 @@ void QtDatePropertyManager::setValue(QtProperty *property, const QDate &val)
 void QtDatePropertyManager::setMinimum(QtProperty *property, const QDate &minVal)
 {
     setMinimumValue<const QDate &, QtDatePropertyManagerPrivate, QtDatePropertyManager, QDate, QtDatePropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtDatePropertyManager::propertyChanged,
+                &QtDatePropertyManager::notifyPropertyChanged,
                 &QtDatePropertyManager::valueChanged,
                 &QtDatePropertyManager::rangeChanged,
                 property, minVal);
@@ -1716,7 +2007,7 @@ void QtDatePropertyManager::setMinimum(QtProperty *property, const QDate &minVal
 void QtDatePropertyManager::setMaximum(QtProperty *property, const QDate &maxVal)
 {
     setMaximumValue<const QDate &, QtDatePropertyManagerPrivate, QtDatePropertyManager, QDate, QtDatePropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtDatePropertyManager::propertyChanged,
+                &QtDatePropertyManager::notifyPropertyChanged,
                 &QtDatePropertyManager::valueChanged,
                 &QtDatePropertyManager::rangeChanged,
                 property, maxVal);
@@ -1741,7 +2032,7 @@ void QtDatePropertyManager::setRange(QtProperty *property, const QDate &minVal,
     void (QtDatePropertyManagerPrivate::*setSubPropertyRange)(QtProperty *, const QDate &,
           const QDate &, const QDate &) = 0;
     setBorderValues<const QDate &, QtDatePropertyManagerPrivate, QtDatePropertyManager, QDate>(this, d_ptr.data(),
-                &QtDatePropertyManager::propertyChanged,
+                &QtDatePropertyManager::notifyPropertyChanged,
                 &QtDatePropertyManager::valueChanged,
                 &QtDatePropertyManager::rangeChanged,
                 property, minVal, maxVal, setSubPropertyRange);
@@ -1862,7 +2153,7 @@ QString QtTimePropertyManager::valueText(const QtProperty *property) const
 void QtTimePropertyManager::setValue(QtProperty *property, const QTime &val)
 {
     setSimpleValue<const QTime &, QTime, QtTimePropertyManager>(d_ptr->m_values, this,
-                &QtTimePropertyManager::propertyChanged,
+                &QtTimePropertyManager::notifyPropertyChanged,
                 &QtTimePropertyManager::valueChanged,
                 property, val);
 }
@@ -1978,7 +2269,7 @@ QString QtDateTimePropertyManager::valueText(const QtProperty *property) const
 void QtDateTimePropertyManager::setValue(QtProperty *property, const QDateTime &val)
 {
     setSimpleValue<const QDateTime &, QDateTime, QtDateTimePropertyManager>(d_ptr->m_values, this,
-                &QtDateTimePropertyManager::propertyChanged,
+                &QtDateTimePropertyManager::notifyPropertyChanged,
                 &QtDateTimePropertyManager::valueChanged,
                 property, val);
 }
@@ -2089,7 +2380,7 @@ QString QtKeySequencePropertyManager::valueText(const QtProperty *property) cons
 void QtKeySequencePropertyManager::setValue(QtProperty *property, const QKeySequence &val)
 {
     setSimpleValue<const QKeySequence &, QKeySequence, QtKeySequencePropertyManager>(d_ptr->m_values, this,
-                &QtKeySequencePropertyManager::propertyChanged,
+                &QtKeySequencePropertyManager::notifyPropertyChanged,
                 &QtKeySequencePropertyManager::valueChanged,
                 property, val);
 }
@@ -2199,7 +2490,7 @@ QString QtCharPropertyManager::valueText(const QtProperty *property) const
 void QtCharPropertyManager::setValue(QtProperty *property, const QChar &val)
 {
     setSimpleValue<const QChar &, QChar, QtCharPropertyManager>(d_ptr->m_values, this,
-                &QtCharPropertyManager::propertyChanged,
+                &QtCharPropertyManager::notifyPropertyChanged,
                 &QtCharPropertyManager::valueChanged,
                 property, val);
 }
@@ -2255,14 +2546,14 @@ void QtLocalePropertyManagerPrivate::slotEnumChanged(QtProperty *property, int v
         const QLocale loc = m_values[prop];
         QLocale::Language newLanguage = loc.language();
         QLocale::Country newCountry = loc.country();
-        metaEnumProvider()->indexToLocale(value, 0, &newLanguage, 0);
+        localeEnumProvider()->indexToLocale(value, 0, &newLanguage, 0);
         QLocale newLoc(newLanguage, newCountry);
         q_ptr->setValue(prop, newLoc);
     } else if (QtProperty *prop = m_countryToProperty.value(property, 0)) {
         const QLocale loc = m_values[prop];
         QLocale::Language newLanguage = loc.language();
         QLocale::Country newCountry = loc.country();
-        metaEnumProvider()->indexToLocale(m_enumPropertyManager->value(m_propertyToLanguage.value(prop)), value, &newLanguage, &newCountry);
+        localeEnumProvider()->indexToLocale(m_enumPropertyManager->value(m_propertyToLanguage.value(prop)), value, &newLanguage, &newCountry);
         QLocale newLoc(newLanguage, newCountry);
         q_ptr->setValue(prop, newLoc);
     }
@@ -2378,7 +2669,7 @@ QString QtLocalePropertyManager::valueText(const QtProperty *property) const
 
     int langIdx = 0;
     int countryIdx = 0;
-    const QtMetaEnumProvider *me = metaEnumProvider();
+    const QtLocaleEnumProvider *me = localeEnumProvider();
     me->localeToIndex(loc.language(), loc.country(), &langIdx, &countryIdx);
     if (langIdx < 0) {
         qWarning("QtLocalePropertyManager::valueText: Unknown language %d", loc.language());
@@ -2415,15 +2706,15 @@ void QtLocalePropertyManager::setValue(QtProperty *property, const QLocale &val)
 
     int langIdx = 0;
     int countryIdx = 0;
-    metaEnumProvider()->localeToIndex(val.language(), val.country(), &langIdx, &countryIdx);
+    localeEnumProvider()->localeToIndex(val.language(), val.country(), &langIdx, &countryIdx);
     if (loc.language() != val.language()) {
         d_ptr->m_enumPropertyManager->setValue(d_ptr->m_propertyToLanguage.value(property), langIdx);
         d_ptr->m_enumPropertyManager->setEnumNames(d_ptr->m_propertyToCountry.value(property),
-                    metaEnumProvider()->countryEnumNames(val.language()));
+                    localeEnumProvider()->countryEnumNames(val.language()));
     }
     d_ptr->m_enumPropertyManager->setValue(d_ptr->m_propertyToCountry.value(property), countryIdx);
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, val);
 }
 
@@ -2437,11 +2728,11 @@ void QtLocalePropertyManager::initializeProperty(QtProperty *property)
 
     int langIdx = 0;
     int countryIdx = 0;
-    metaEnumProvider()->localeToIndex(val.language(), val.country(), &langIdx, &countryIdx);
+    localeEnumProvider()->localeToIndex(val.language(), val.country(), &langIdx, &countryIdx);
 
     QtProperty *languageProp = d_ptr->m_enumPropertyManager->addProperty();
     languageProp->setPropertyName(tr("Language"));
-    d_ptr->m_enumPropertyManager->setEnumNames(languageProp, metaEnumProvider()->languageEnumNames());
+    d_ptr->m_enumPropertyManager->setEnumNames(languageProp, localeEnumProvider()->languageEnumNames());
     d_ptr->m_enumPropertyManager->setValue(languageProp, langIdx);
     d_ptr->m_propertyToLanguage[property] = languageProp;
     d_ptr->m_languageToProperty[languageProp] = property;
@@ -2449,7 +2740,7 @@ void QtLocalePropertyManager::initializeProperty(QtProperty *property)
 
     QtProperty *countryProp = d_ptr->m_enumPropertyManager->addProperty();
     countryProp->setPropertyName(tr("Country"));
-    d_ptr->m_enumPropertyManager->setEnumNames(countryProp, metaEnumProvider()->countryEnumNames(val.language()));
+    d_ptr->m_enumPropertyManager->setEnumNames(countryProp, localeEnumProvider()->countryEnumNames(val.language()));
     d_ptr->m_enumPropertyManager->setValue(countryProp, countryIdx);
     d_ptr->m_propertyToCountry[property] = countryProp;
     d_ptr->m_countryToProperty[countryProp] = property;
@@ -2643,7 +2934,7 @@ void QtPointPropertyManager::setValue(QtProperty *property, const QPoint &val)
     d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToX[property], val.x());
     d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToY[property], val.y());
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, val);
 }
 
@@ -2883,7 +3174,7 @@ void QtPointFPropertyManager::setValue(QtProperty *property, const QPointF &val)
     d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToX[property], val.x());
     d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToY[property], val.y());
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, val);
 }
 
@@ -3195,7 +3486,7 @@ QString QtSizePropertyManager::valueText(const QtProperty *property) const
 void QtSizePropertyManager::setValue(QtProperty *property, const QSize &val)
 {
     setValueInRange<const QSize &, QtSizePropertyManagerPrivate, QtSizePropertyManager, const QSize>(this, d_ptr.data(),
-                &QtSizePropertyManager::propertyChanged,
+                &QtSizePropertyManager::notifyPropertyChanged,
                 &QtSizePropertyManager::valueChanged,
                 property, val, &QtSizePropertyManagerPrivate::setValue);
 }
@@ -3212,7 +3503,7 @@ void QtSizePropertyManager::setValue(QtProperty *property, const QSize &val)
 void QtSizePropertyManager::setMinimum(QtProperty *property, const QSize &minVal)
 {
     setBorderValue<const QSize &, QtSizePropertyManagerPrivate, QtSizePropertyManager, QSize, QtSizePropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtSizePropertyManager::propertyChanged,
+                &QtSizePropertyManager::notifyPropertyChanged,
                 &QtSizePropertyManager::valueChanged,
                 &QtSizePropertyManager::rangeChanged,
                 property,
@@ -3233,7 +3524,7 @@ void QtSizePropertyManager::setMinimum(QtProperty *property, const QSize &minVal
 void QtSizePropertyManager::setMaximum(QtProperty *property, const QSize &maxVal)
 {
     setBorderValue<const QSize &, QtSizePropertyManagerPrivate, QtSizePropertyManager, QSize, QtSizePropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtSizePropertyManager::propertyChanged,
+                &QtSizePropertyManager::notifyPropertyChanged,
                 &QtSizePropertyManager::valueChanged,
                 &QtSizePropertyManager::rangeChanged,
                 property,
@@ -3259,7 +3550,7 @@ void QtSizePropertyManager::setMaximum(QtProperty *property, const QSize &maxVal
 void QtSizePropertyManager::setRange(QtProperty *property, const QSize &minVal, const QSize &maxVal)
 {
     setBorderValues<const QSize &, QtSizePropertyManagerPrivate, QtSizePropertyManager, QSize>(this, d_ptr.data(),
-                &QtSizePropertyManager::propertyChanged,
+                &QtSizePropertyManager::notifyPropertyChanged,
                 &QtSizePropertyManager::valueChanged,
                 &QtSizePropertyManager::rangeChanged,
                 property, minVal, maxVal, &QtSizePropertyManagerPrivate::setRange);
@@ -3559,7 +3850,7 @@ QString QtSizeFPropertyManager::valueText(const QtProperty *property) const
 void QtSizeFPropertyManager::setValue(QtProperty *property, const QSizeF &val)
 {
     setValueInRange<const QSizeF &, QtSizeFPropertyManagerPrivate, QtSizeFPropertyManager, QSizeF>(this, d_ptr.data(),
-                &QtSizeFPropertyManager::propertyChanged,
+                &QtSizeFPropertyManager::notifyPropertyChanged,
                 &QtSizeFPropertyManager::valueChanged,
                 property, val, &QtSizeFPropertyManagerPrivate::setValue);
 }
@@ -3610,7 +3901,7 @@ void QtSizeFPropertyManager::setDecimals(QtProperty *property, int prec)
 void QtSizeFPropertyManager::setMinimum(QtProperty *property, const QSizeF &minVal)
 {
     setBorderValue<const QSizeF &, QtSizeFPropertyManagerPrivate, QtSizeFPropertyManager, QSizeF, QtSizeFPropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtSizeFPropertyManager::propertyChanged,
+                &QtSizeFPropertyManager::notifyPropertyChanged,
                 &QtSizeFPropertyManager::valueChanged,
                 &QtSizeFPropertyManager::rangeChanged,
                 property,
@@ -3631,7 +3922,7 @@ void QtSizeFPropertyManager::setMinimum(QtProperty *property, const QSizeF &minV
 void QtSizeFPropertyManager::setMaximum(QtProperty *property, const QSizeF &maxVal)
 {
     setBorderValue<const QSizeF &, QtSizeFPropertyManagerPrivate, QtSizeFPropertyManager, QSizeF, QtSizeFPropertyManagerPrivate::Data>(this, d_ptr.data(),
-                &QtSizeFPropertyManager::propertyChanged,
+                &QtSizeFPropertyManager::notifyPropertyChanged,
                 &QtSizeFPropertyManager::valueChanged,
                 &QtSizeFPropertyManager::rangeChanged,
                 property,
@@ -3657,7 +3948,7 @@ void QtSizeFPropertyManager::setMaximum(QtProperty *property, const QSizeF &maxV
 void QtSizeFPropertyManager::setRange(QtProperty *property, const QSizeF &minVal, const QSizeF &maxVal)
 {
     setBorderValues<const QSizeF &, QtSizeFPropertyManagerPrivate, QtSizeFPropertyManager, QSizeF>(this, d_ptr.data(),
-                &QtSizeFPropertyManager::propertyChanged,
+                &QtSizeFPropertyManager::notifyPropertyChanged,
                 &QtSizeFPropertyManager::valueChanged,
                 &QtSizeFPropertyManager::rangeChanged,
                 property, minVal, maxVal, &QtSizeFPropertyManagerPrivate::setRange);
@@ -3982,7 +4273,7 @@ void QtRectPropertyManager::setValue(QtProperty *property, const QRect &val)
     d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToW[property], newRect.width());
     d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToH[property], newRect.height());
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, data.val);
 }
 
@@ -4041,7 +4332,7 @@ void QtRectPropertyManager::setConstraint(QtProperty *property, const QRect &con
     if (data.val == oldVal)
         return;
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, data.val);
 }
 
@@ -4412,7 +4703,7 @@ void QtRectFPropertyManager::setValue(QtProperty *property, const QRectF &val)
     d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToW[property], newRect.width());
     d_ptr->m_doublePropertyManager->setValue(d_ptr->m_propertyToH[property], newRect.height());
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, data.val);
 }
 
@@ -4471,7 +4762,7 @@ void QtRectFPropertyManager::setConstraint(QtProperty *property, const QRectF &c
     if (data.val == oldVal)
         return;
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, data.val);
 }
 
@@ -4589,19 +4880,131 @@ void QtRectFPropertyManager::uninitializeProperty(QtProperty *property)
     d_ptr->m_values.remove(property);
 }
 
+// Interned enum and flag name tables. Properties with equal names and icons
+// share one QtEnumDefinition, so a table is stored once no matter how many
+// properties use it and two tables compare equal by pointer. A null handle
+// stands for the empty table.
+
+class QtEnumDefinition : public QSharedData
+{
+public:
+    QStringList names;
+    QMap<int, QIcon> icons;
+};
+
+typedef QExplicitlySharedDataPointer<QtEnumDefinition> QtEnumDefinitionHandle;
+
+class QtEnumDefinitionRegistry
+{
+public:
+    QtEnumDefinitionHandle intern(const QStringList &names, const QMap<int, QIcon> &icons);
+
+private:
+    static bool matches(const QtEnumDefinition *definition,
+                const QStringList &names, const QMap<int, QIcon> &icons);
+    void purge();
+
+    QMutex m_mutex;
+    QMultiHash<uint, QtEnumDefinitionHandle> m_definitions;
+    QtEnumDefinitionHandle m_lastDefinition;
+    int m_purgeThreshold{64};
+};
+
+Q_GLOBAL_STATIC(QtEnumDefinitionRegistry, enumDefinitionRegistry)
+
+bool QtEnumDefinitionRegistry::matches(const QtEnumDefinition *definition,
+            const QStringList &names, const QMap<int, QIcon> &icons)
+{
+    if (definition->names != names || definition->icons.count() != icons.count())
+        return false;
+
+    auto it = definition->icons.constBegin();
+    auto other = icons.constBegin();
+    for ( ; it != definition->icons.constEnd(); ++it, ++other) {
+        if (it.key() != other.key() || it.value().cacheKey() != other.value().cacheKey())
+            return false;
+    }
+    return true;
+}
+
+QtEnumDefinitionHandle QtEnumDefinitionRegistry::intern(const QStringList &names,
+            const QMap<int, QIcon> &icons)
+{
+    QMutexLocker locker(&m_mutex);
+    // The same shared list is often set on many properties in a row, e.g.
+    // the font families; comparing it against the last table is cheap then.
+    if (m_lastDefinition && matches(m_lastDefinition.data(), names, icons))
+        return m_lastDefinition;
+
+    const uint key = qHash(names);
+    for (auto it = m_definitions.constFind(key); it != m_definitions.constEnd() && it.key() == key; ++it) {
+        if (matches(it.value().data(), names, icons)) {
+            m_lastDefinition = it.value();
+            return it.value();
+        }
+    }
+
+    QtEnumDefinitionHandle definition(new QtEnumDefinition);
+    definition->names = names;
+    definition->icons = icons;
+    m_definitions.insert(key, definition);
+    m_lastDefinition = definition;
+    if (m_definitions.size() > m_purgeThreshold)
+        purge();
+    return definition;
+}
+
+// Drops tables no property refers to any more, i.e. the ones only the
+// registry itself holds. Runs whenever the registry doubled in size.
+void QtEnumDefinitionRegistry::purge()
+{
+    for (auto it = m_definitions.begin(); it != m_definitions.end(); ) {
+        if (it.value()->ref.loadAcquire() == 1)
+            it = m_definitions.erase(it);
+        else
+            ++it;
+    }
+    m_purgeThreshold = qMax(64, 2 * m_definitions.size());
+}
+
+static QtEnumDefinitionHandle internEnumDefinition(const QStringList &names,
+            const QMap<int, QIcon> &icons = QMap<int, QIcon>())
+{
+    if (names.isEmpty() && icons.isEmpty())
+        return QtEnumDefinitionHandle();
+
+    if (QtEnumDefinitionRegistry *registry = enumDefinitionRegistry())
+        return registry->intern(names, icons);
+
+    // registry already gone during static destruction
+    QtEnumDefinitionHandle definition(new QtEnumDefinition);
+    definition->names = names;
+    definition->icons = icons;
+    return definition;
+}
+
 // QtEnumPropertyManager
 
-class QtEnumPropertyManagerPrivate
+class QtEnumPropertyManagerPrivate : public QtInlineEditing
 {
     QtEnumPropertyManager *q_ptr;
     Q_DECLARE_PUBLIC(QtEnumPropertyManager)
 public:
 
+    ValueType inlineValueType(const QtProperty *) const { return EnumValue; }
+    QVariant inlineValue(const QtProperty *property) const { return q_ptr->value(property); }
+    void setInlineValue(QtProperty *property, const QVariant &value) { q_ptr->setValue(property, value.toInt()); }
+    QStringList inlineEnumNames(const QtProperty *property) const { return q_ptr->enumNames(property); }
+    QMap<int, QIcon> inlineEnumIcons(const QtProperty *property) const { return q_ptr->enumIcons(property); }
+
     struct Data
     {
         int val{-1};
-        QStringList enumNames;
-        QMap<int, QIcon> enumIcons;
+        QtEnumDefinitionHandle definition;
+
+        QStringList enumNames() const { return definition ? definition->names : QStringList(); }
+        QMap<int, QIcon> enumIcons() const { return definition ? definition->icons : QMap<int, QIcon>(); }
+        int count() const { return definition ? definition->names.count() : 0; }
     };
 
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
@@ -4702,7 +5105,10 @@ int QtEnumPropertyManager::value(const QtProperty *property) const
 */
 QStringList QtEnumPropertyManager::enumNames(const QtProperty *property) const
 {
-    return getData<QStringList>(d_ptr->m_values, &QtEnumPropertyManagerPrivate::Data::enumNames, property, QStringList());
+    const auto it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return QStringList();
+    return it.value().enumNames();
 }
 
 /*!
@@ -4712,7 +5118,18 @@ QStringList QtEnumPropertyManager::enumNames(const QtProperty *property) const
 */
 QMap<int, QIcon> QtEnumPropertyManager::enumIcons(const QtProperty *property) const
 {
-    return getData<QMap<int, QIcon> >(d_ptr->m_values, &QtEnumPropertyManagerPrivate::Data::enumIcons, property, QMap<int, QIcon>());
+    const auto it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return QMap<int, QIcon>();
+    return it.value().enumIcons();
+}
+
+/*!
+    \reimp
+*/
+QtInlineEditing *QtEnumPropertyManager::inlineEditing() const
+{
+    return d_ptr.data();
 }
 
 /*!
@@ -4727,8 +5144,8 @@ QString QtEnumPropertyManager::valueText(const QtProperty *property) const
     const QtEnumPropertyManagerPrivate::Data &data = it.value();
 
     const int v = data.val;
-    if (v >= 0 && v < data.enumNames.count())
-        return data.enumNames.at(v);
+    if (v >= 0 && v < data.count())
+        return data.definition->names.at(v);
     return QString();
 }
 
@@ -4744,7 +5161,9 @@ QIcon QtEnumPropertyManager::valueIcon(const QtProperty *property) const
     const QtEnumPropertyManagerPrivate::Data &data = it.value();
 
     const int v = data.val;
-    return data.enumIcons.value(v);
+    if (!data.definition)
+        return QIcon();
+    return data.definition->icons.value(v);
 }
 
 /*!
@@ -4765,10 +5184,10 @@ void QtEnumPropertyManager::setValue(QtProperty *property, int val)
 
     QtEnumPropertyManagerPrivate::Data data = it.value();
 
-    if (val >= data.enumNames.count())
+    if (val >= data.count())
         return;
 
-    if (val < 0 && data.enumNames.count() > 0)
+    if (val < 0 && data.count() > 0)
         return;
 
     if (val < 0)
@@ -4781,7 +5200,7 @@ void QtEnumPropertyManager::setValue(QtProperty *property, int val)
 
     it.value() = data;
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, data.val);
 }
 
@@ -4803,10 +5222,11 @@ void QtEnumPropertyManager::setEnumNames(QtProperty *property, const QStringList
 
     QtEnumPropertyManagerPrivate::Data data = it.value();
 
-    if (data.enumNames == enumNames)
+    const QtEnumDefinitionHandle definition = internEnumDefinition(enumNames, data.enumIcons());
+    if (data.definition == definition)
         return;
 
-    data.enumNames = enumNames;
+    data.definition = definition;
 
     data.val = -1;
 
@@ -4815,9 +5235,9 @@ void QtEnumPropertyManager::setEnumNames(QtProperty *property, const QStringList
 
     it.value() = data;
 
-    emit enumNamesChanged(property, data.enumNames);
+    emit enumNamesChanged(property, data.enumNames());
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, data.val);
 }
 
@@ -4835,11 +5255,12 @@ void QtEnumPropertyManager::setEnumIcons(QtProperty *property, const QMap<int, Q
     if (it == d_ptr->m_values.end())
         return;
 
-    it.value().enumIcons = enumIcons;
+    QtEnumPropertyManagerPrivate::Data &data = it.value();
+    data.definition = internEnumDefinition(data.enumNames(), enumIcons);
 
-    emit enumIconsChanged(property, it.value().enumIcons);
+    emit enumIconsChanged(property, data.enumIcons());
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
 }
 
 /*!
@@ -4869,10 +5290,18 @@ public:
     void slotBoolChanged(QtProperty *property, bool value);
     void slotPropertyDestroyed(QtProperty *property);
 
+    static int lowBits(const QBitArray &bits);
+    void syncSubProperties(const QtProperty *property, const QBitArray &changed);
+    void updateSubProperties(QtProperty *property, bool create);
+
     struct Data
     {
-        int val{-1};
-        QStringList flagNames;
+        int val{-1}; // the first 31 bits, kept for the int based API
+        QBitArray bits;
+        QtEnumDefinitionHandle definition;
+
+        QStringList flagNames() const { return definition ? definition->names : QStringList(); }
+        int count() const { return definition ? definition->names.count() : 0; }
     };
 
     typedef QMap<const QtProperty *, Data> PropertyValueMap;
@@ -4883,10 +5312,17 @@ public:
     QMap<const QtProperty *, QList<QtProperty *> > m_propertyToFlags;
 
     QMap<const QtProperty *, QtProperty *> m_flagToProperty;
+
+    bool m_syncing{false};
+    bool m_subPropertiesDeferred{false};
 };
 
 void QtFlagPropertyManagerPrivate::slotBoolChanged(QtProperty *property, bool value)
 {
+    // changes made while syncing the subproperties are already in m_values
+    if (m_syncing)
+        return;
+
     QtProperty *prop = m_flagToProperty.value(property, 0);
     if (prop == 0)
         return;
@@ -4894,20 +5330,9 @@ void QtFlagPropertyManagerPrivate::slotBoolChanged(QtProperty *property, bool va
     const auto pfit = m_propertyToFlags.constFind(prop);
     if (pfit == m_propertyToFlags.constEnd())
             return;
-    int level = 0;
-    for (QtProperty *p : pfit.value()) {
-        if (p == property) {
-            int v = m_values[prop].val;
-            if (value) {
-                v |= (1 << level);
-            } else {
-                v &= ~(1 << level);
-            }
-            q_ptr->setValue(prop, v);
-            return;
-        }
-        level++;
-    }
+    const int level = pfit.value().indexOf(property);
+    if (level >= 0)
+        q_ptr->setFlag(prop, level, value);
 }
 
 void QtFlagPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
@@ -4920,6 +5345,77 @@ void QtFlagPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
     m_flagToProperty.remove(property);
 }
 
+int QtFlagPropertyManagerPrivate::lowBits(const QBitArray &bits)
+{
+    int val = 0;
+    const int count = qMin(bits.size(), 31);
+    for (int i = 0; i < count; i++) {
+        if (bits.testBit(i))
+            val |= (1 << i);
+    }
+    return val;
+}
+
+// Pushes the bits set in \a changed to the boolean subproperties.
+void QtFlagPropertyManagerPrivate::syncSubProperties(const QtProperty *property, const QBitArray &changed)
+{
+    const auto pfit = m_propertyToFlags.constFind(property);
+    if (pfit == m_propertyToFlags.constEnd())
+        return;
+
+    const QBitArray &bits = m_values[property].bits;
+    const QList<QtProperty *> &flags = pfit.value();
+    const int count = qMin(flags.count(), changed.size());
+    const bool wasSyncing = m_syncing;
+    m_syncing = true;
+    for (int i = 0; i < count; i++) {
+        if (changed.testBit(i) && flags.at(i))
+            m_boolPropertyManager->setValue(flags.at(i), bits.testBit(i));
+    }
+    m_syncing = wasSyncing;
+}
+
+// Brings the boolean subproperties in line with the flag names, reusing
+// the existing ones. Creates them from scratch only if \a create is true.
+void QtFlagPropertyManagerPrivate::updateSubProperties(QtProperty *property, bool create)
+{
+    QList<QtProperty *> &flags = m_propertyToFlags[property];
+    if (flags.isEmpty() && !create)
+        return;
+
+    const Data &data = m_values[property];
+    const QStringList names = data.flagNames();
+    const int count = names.count();
+
+    while (flags.count() > count) {
+        QtProperty *prop = flags.takeLast();
+        if (prop) {
+            m_flagToProperty.remove(prop);
+            delete prop;
+        }
+    }
+
+    const bool wasSyncing = m_syncing;
+    m_syncing = true;
+    QtProperty *after = 0;
+    for (int i = 0; i < count; i++) {
+        QtProperty *prop = i < flags.count() ? flags.at(i) : 0;
+        if (!prop) {
+            prop = m_boolPropertyManager->addProperty();
+            property->insertSubProperty(prop, after);
+            m_flagToProperty[prop] = property;
+            if (i < flags.count())
+                flags[i] = prop;
+            else
+                flags.append(prop);
+        }
+        prop->setPropertyName(names.at(i));
+        m_boolPropertyManager->setValue(prop, data.bits.testBit(i));
+        after = prop;
+    }
+    m_syncing = wasSyncing;
+}
+
 /*!
     \class QtFlagPropertyManager
     \internal
@@ -4936,20 +5432,23 @@ void QtFlagPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
     subproperties representing each flag, i.e. a flag property's value
     is the binary combination of the subproperties' values. A
     property's value can be retrieved and set using the value() and
-    setValue() slots respectively. The combination of flags is represented
-    by single int value - that's why it's possible to store up to
-    32 independent flags in one flag property.
+    setValue() slots respectively. The int based value() and setValue()
+    cover the first 31 flags. Properties with more flags are read and
+    written as a QBitArray using bitValue() and setBitValue(), or one flag
+    at a time using testFlag() and setFlag(). Only the subproperties of
+    flags that actually change are updated.
 
     The subproperties are created by a QtBoolPropertyManager object. This
     manager can be retrieved using the subBoolPropertyManager() function. In
     order to provide editing widgets for the subproperties in a
     property browser widget, this manager must be associated with an
-    editor factory.
+    editor factory. For properties with many flags the subproperties can
+    be created on demand, see setSubPropertiesDeferred().
 
-    In addition, QtFlagPropertyManager provides the valueChanged() signal
-    which is emitted whenever a property created by this manager
-    changes, and the flagNamesChanged() signal which is emitted
-    whenever the list of flag names is altered.
+    In addition, QtFlagPropertyManager provides the valueChanged() and
+    bitValueChanged() signals which are emitted whenever a property
+    created by this manager changes, and the flagNamesChanged() signal
+    which is emitted whenever the list of flag names is altered.
 
     \sa QtAbstractPropertyManager, QtBoolPropertyManager
 */
@@ -4964,6 +5463,17 @@ void QtFlagPropertyManagerPrivate::slotPropertyDestroyed(QtProperty *property)
     \sa setValue()
 */
 
+/*!
+    \fn void QtFlagPropertyManager::bitValueChanged(QtProperty *property, const QBitArray &value)
+
+    This signal is emitted whenever a property created by this manager
+    changes its value, passing a pointer to the \a property and the
+    complete new \a value as parameters. It is emitted once per change,
+    however many flags were flipped.
+
+    \sa setBitValue()
+*/
+
 /*!
     \fn void QtFlagPropertyManager::flagNamesChanged(QtProperty *property, const QStringList &names)
 
@@ -5032,7 +5542,10 @@ int QtFlagPropertyManager::value(const QtProperty *property) const
 */
 QStringList QtFlagPropertyManager::flagNames(const QtProperty *property) const
 {
-    return getData<QStringList>(d_ptr->m_values, &QtFlagPropertyManagerPrivate::Data::flagNames, property, QStringList());
+    const auto it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return QStringList();
+    return it.value().flagNames();
 }
 
 /*!
@@ -5049,9 +5562,10 @@ QString QtFlagPropertyManager::valueText(const QtProperty *property) const
     QString str;
     int level = 0;
     const QChar bar = QLatin1Char('|');
-    const QStringList::const_iterator fncend = data.flagNames.constEnd();
-    for (QStringList::const_iterator it =  data.flagNames.constBegin(); it != fncend; ++it) {
-        if (data.val & (1 << level)) {
+    const QStringList flagNames = data.flagNames();
+    const QStringList::const_iterator fncend = flagNames.constEnd();
+    for (QStringList::const_iterator it =  flagNames.constBegin(); it != fncend; ++it) {
+        if (data.bits.testBit(level)) {
             if (!str.isEmpty())
                 str += bar;
             str += *it;
@@ -5071,43 +5585,184 @@ QString QtFlagPropertyManager::valueText(const QtProperty *property) const
     The specified \a value must be less than the binary combination of
     the property's flagNames() list size (i.e. less than 2\sup n,
     where \c n is the size of the list) and larger than (or equal to)
-    0.
+    0. Flags beyond the first 31 are cleared; use setBitValue() to set
+    them.
 
-    \sa value(), valueChanged()
+    \sa value(), valueChanged(), setBitValue()
 */
 void QtFlagPropertyManager::setValue(QtProperty *property, int val)
+{
+    const QtFlagPropertyManagerPrivate::PropertyValueMap::const_iterator it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return;
+
+    const int count = it.value().count();
+
+    if (val < 0)
+        return;
+
+    if (count < 31 && val > (1 << count) - 1)
+        return;
+
+    QBitArray bits(count);
+    const int lowCount = qMin(count, 31);
+    for (int i = 0; i < lowCount; i++) {
+        if (val & (1 << i))
+            bits.setBit(i);
+    }
+    setBitValue(property, bits);
+}
+
+/*!
+    Returns the given \a property's value with one bit per flag.
+
+    If the given property is not managed by this manager, this
+    function returns an empty bit array.
+
+    \sa setBitValue(), testFlag()
+*/
+QBitArray QtFlagPropertyManager::bitValue(const QtProperty *property) const
+{
+    return getData<QBitArray>(d_ptr->m_values, &QtFlagPropertyManagerPrivate::Data::bits, property, QBitArray());
+}
+
+/*!
+    Returns whether the flag at position \a index of the given \a
+    property is set.
+
+    \sa setFlag(), bitValue()
+*/
+bool QtFlagPropertyManager::testFlag(const QtProperty *property, int index) const
+{
+    const auto it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
+        return false;
+    const QBitArray &bits = it.value().bits;
+    return index >= 0 && index < bits.size() && bits.testBit(index);
+}
+
+/*!
+    \fn void QtFlagPropertyManager::setBitValue(QtProperty *property, const QBitArray &value)
+
+    Sets the value of the given \a property to \a value, one bit per
+    flag. A shorter \a value leaves the remaining flags cleared; a
+    longer one is rejected if any of the surplus bits is set.
+
+    Only the subproperties of flags that change are updated, and the
+    valueChanged() and bitValueChanged() signals are emitted once.
+
+    \sa bitValue(), setFlag(), bitValueChanged()
+*/
+void QtFlagPropertyManager::setBitValue(QtProperty *property, const QBitArray &val)
 {
     const QtFlagPropertyManagerPrivate::PropertyValueMap::iterator it = d_ptr->m_values.find(property);
     if (it == d_ptr->m_values.end())
         return;
 
-    QtFlagPropertyManagerPrivate::Data data = it.value();
+    QtFlagPropertyManagerPrivate::Data &data = it.value();
+    const int count = data.count();
 
-    if (data.val == val)
+    QBitArray bits = val;
+    for (int i = count; i < bits.size(); i++) {
+        if (bits.testBit(i))
+            return;
+    }
+    bits.resize(count);
+
+    if (data.val >= 0 && data.bits == bits)
         return;
 
-    if (val > (1 << data.flagNames.count()) - 1)
+    const QBitArray changed = data.bits ^ bits;
+    const int lowVal = QtFlagPropertyManagerPrivate::lowBits(bits);
+    data.bits = bits;
+    data.val = lowVal;
+
+    d_ptr->syncSubProperties(property, changed);
+
+    notifyPropertyChanged(property);
+    emit valueChanged(property, lowVal);
+    emit bitValueChanged(property, bits);
+}
+
+/*!
+    Sets the flag at position \a index of the given \a property to \a on.
+
+    \sa testFlag(), setBitValue()
+*/
+void QtFlagPropertyManager::setFlag(QtProperty *property, int index, bool on)
+{
+    const auto it = d_ptr->m_values.constFind(property);
+    if (it == d_ptr->m_values.constEnd())
         return;
 
-    if (val < 0)
+    QBitArray bits = it.value().bits;
+    if (index < 0 || index >= bits.size() || bits.testBit(index) == on)
         return;
 
-    data.val = val;
+    bits.setBit(index, on);
+    setBitValue(property, bits);
+}
 
-    it.value() = data;
+/*!
+    Returns whether boolean subproperties are only created on request.
 
-    const auto pfit = d_ptr->m_propertyToFlags.constFind(property);
-    int level = 0;
-    if (pfit != d_ptr->m_propertyToFlags.constEnd()) {
-        for (QtProperty *prop : pfit.value()) {
-            if (prop)
-                d_ptr->m_boolPropertyManager->setValue(prop, val & (1 << level));
-            level++;
-        }
-    }
+    \sa setSubPropertiesDeferred(), createSubProperties()
+*/
+bool QtFlagPropertyManager::subPropertiesDeferred() const
+{
+    return d_ptr->m_subPropertiesDeferred;
+}
 
-    emit propertyChanged(property);
-    emit valueChanged(property, data.val);
+/*!
+    Sets whether properties get their boolean subproperties only when
+    createSubProperties() is called to \a defer. By default the
+    subproperties are created together with the flag names.
+
+    Deferring is useful for properties with many flags that are rarely
+    expanded. Their value and value text are maintained regardless.
+    Property browsers create the subproperties through
+    QtProperty::createDeferredSubProperties(): QtTreePropertyBrowser when
+    the property is expanded, the other browsers when the property is
+    shown.
+
+    \sa createSubProperties()
+*/
+void QtFlagPropertyManager::setSubPropertiesDeferred(bool defer)
+{
+    d_ptr->m_subPropertiesDeferred = defer;
+}
+
+/*!
+    Creates the boolean subproperties of the given \a property if they
+    do not exist yet, e.g. when the property is about to be expanded
+    in a browser.
+
+    \sa setSubPropertiesDeferred()
+*/
+void QtFlagPropertyManager::createSubProperties(QtProperty *property)
+{
+    if (!d_ptr->m_values.contains(property))
+        return;
+
+    d_ptr->updateSubProperties(property, true);
+}
+
+/*!
+    \reimp
+*/
+bool QtFlagPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
+{
+    if (!d_ptr->m_subPropertiesDeferred || d_ptr->m_propertyToFlags.value(property).count())
+        return false;
+    return d_ptr->m_values.value(property).count() > 0;
+}
+
+/*!
+    \reimp
+*/
+void QtFlagPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    createSubProperties(property);
 }
 
 /*!
@@ -5115,6 +5770,9 @@ void QtFlagPropertyManager::setValue(QtProperty *property, int val)
     property's current value is reset to 0 indicating the first item
     of the list.
 
+    Existing subproperties are reused and renamed; only the difference
+    in the number of flags is created or deleted.
+
     \sa flagNames(), flagNamesChanged()
 */
 void QtFlagPropertyManager::setFlagNames(QtProperty *property, const QStringList &flagNames)
@@ -5123,39 +5781,24 @@ void QtFlagPropertyManager::setFlagNames(QtProperty *property, const QStringList
     if (it == d_ptr->m_values.end())
         return;
 
-    QtFlagPropertyManagerPrivate::Data data = it.value();
+    QtFlagPropertyManagerPrivate::Data &data = it.value();
 
-    if (data.flagNames == flagNames)
+    const QtEnumDefinitionHandle definition = internEnumDefinition(flagNames);
+    if (data.definition == definition)
         return;
 
-    data.flagNames = flagNames;
+    data.definition = definition;
+    data.bits = QBitArray(flagNames.count());
     data.val = 0;
 
-    it.value() = data;
-
-    const auto pfit = d_ptr->m_propertyToFlags.find(property);
-    if (pfit != d_ptr->m_propertyToFlags.end()) {
-        for (QtProperty *prop : qAsConst(pfit.value())) {
-            if (prop) {
-                delete prop;
-                d_ptr->m_flagToProperty.remove(prop);
-            }
-        }
-        pfit.value().clear();
-    }
-
-    for (const QString &flagName : flagNames) {
-        QtProperty *prop = d_ptr->m_boolPropertyManager->addProperty();
-        prop->setPropertyName(flagName);
-        property->addSubProperty(prop);
-        d_ptr->m_propertyToFlags[property].append(prop);
-        d_ptr->m_flagToProperty[prop] = property;
-    }
+    d_ptr->updateSubProperties(property, !d_ptr->m_subPropertiesDeferred);
 
-    emit flagNamesChanged(property, data.flagNames);
+    emit flagNamesChanged(property, definition ? definition->names : QStringList());
 
-    emit propertyChanged(property);
-    emit valueChanged(property, data.val);
+    const QBitArray bits(flagNames.count());
+    notifyPropertyChanged(property);
+    emit valueChanged(property, 0);
+    emit bitValueChanged(property, bits);
 }
 
 /*!
@@ -5239,11 +5882,11 @@ void QtSizePolicyPropertyManagerPrivate::slotEnumChanged(QtProperty *property, i
 {
     if (QtProperty *prop = m_hPolicyToProperty.value(property, 0)) {
         QSizePolicy sp = m_values[prop];
-        sp.setHorizontalPolicy(metaEnumProvider()->indexToSizePolicy(value));
+        sp.setHorizontalPolicy(sizePolicyEnumProvider()->indexToSizePolicy(value));
         q_ptr->setValue(prop, sp);
     } else if (QtProperty *prop = m_vPolicyToProperty.value(property, 0)) {
         QSizePolicy sp = m_values[prop];
-        sp.setVerticalPolicy(metaEnumProvider()->indexToSizePolicy(value));
+        sp.setVerticalPolicy(sizePolicyEnumProvider()->indexToSizePolicy(value));
         q_ptr->setValue(prop, sp);
     }
 }
@@ -5383,7 +6026,7 @@ QString QtSizePolicyPropertyManager::valueText(const QtProperty *property) const
         return QString();
 
     const QSizePolicy sp = it.value();
-    const QtMetaEnumProvider *mep = metaEnumProvider();
+    const QtSizePolicyEnumProvider *mep = sizePolicyEnumProvider();
     const int hIndex = mep->sizePolicyToIndex(sp.horizontalPolicy());
     const int vIndex = mep->sizePolicyToIndex(sp.verticalPolicy());
     //! Unknown size policy on reading invalid uic3 files
@@ -5413,15 +6056,15 @@ void QtSizePolicyPropertyManager::setValue(QtProperty *property, const QSizePoli
     it.value() = val;
 
     d_ptr->m_enumPropertyManager->setValue(d_ptr->m_propertyToHPolicy[property],
-                metaEnumProvider()->sizePolicyToIndex(val.horizontalPolicy()));
+                sizePolicyEnumProvider()->sizePolicyToIndex(val.horizontalPolicy()));
     d_ptr->m_enumPropertyManager->setValue(d_ptr->m_propertyToVPolicy[property],
-                metaEnumProvider()->sizePolicyToIndex(val.verticalPolicy()));
+                sizePolicyEnumProvider()->sizePolicyToIndex(val.verticalPolicy()));
     d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToHStretch[property],
                 val.horizontalStretch());
     d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToVStretch[property],
                 val.verticalStretch());
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, val);
 }
 
@@ -5435,18 +6078,18 @@ void QtSizePolicyPropertyManager::initializeProperty(QtProperty *property)
 
     QtProperty *hPolicyProp = d_ptr->m_enumPropertyManager->addProperty();
     hPolicyProp->setPropertyName(tr("Horizontal Policy"));
-    d_ptr->m_enumPropertyManager->setEnumNames(hPolicyProp, metaEnumProvider()->policyEnumNames());
+    d_ptr->m_enumPropertyManager->setEnumNames(hPolicyProp, sizePolicyEnumProvider()->policyEnumNames());
     d_ptr->m_enumPropertyManager->setValue(hPolicyProp,
-                metaEnumProvider()->sizePolicyToIndex(val.horizontalPolicy()));
+                sizePolicyEnumProvider()->sizePolicyToIndex(val.horizontalPolicy()));
     d_ptr->m_propertyToHPolicy[property] = hPolicyProp;
     d_ptr->m_hPolicyToProperty[hPolicyProp] = property;
     property->addSubProperty(hPolicyProp);
 
     QtProperty *vPolicyProp = d_ptr->m_enumPropertyManager->addProperty();
     vPolicyProp->setPropertyName(tr("Vertical Policy"));
-    d_ptr->m_enumPropertyManager->setEnumNames(vPolicyProp, metaEnumProvider()->policyEnumNames());
+    d_ptr->m_enumPropertyManager->setEnumNames(vPolicyProp, sizePolicyEnumProvider()->policyEnumNames());
     d_ptr->m_enumPropertyManager->setValue(vPolicyProp,
-                metaEnumProvider()->sizePolicyToIndex(val.verticalPolicy()));
+                sizePolicyEnumProvider()->sizePolicyToIndex(val.verticalPolicy()));
     d_ptr->m_propertyToVPolicy[property] = vPolicyProp;
     d_ptr->m_vPolicyToProperty[vPolicyProp] = property;
     property->addSubProperty(vPolicyProp);
@@ -5512,9 +6155,93 @@ void QtSizePolicyPropertyManager::uninitializeProperty(QtProperty *property)
 // using a timer with interval 0, which then causes the family
 // enumeration manager to re-set its strings and index values
 // for each property.
+// The family list itself lives in a catalog shared by all font managers,
+// so every family property refers to the same list and a family is mapped
+// to its index through a hash.
 
 Q_GLOBAL_STATIC(QFontDatabase, fontDatabase)
 
+class QtFontFamilyCatalog
+{
+public:
+    QtFontFamilyCatalog() : m_loaded(false) {}
+
+    QStringList families();
+    bool isCurrent(const QStringList &families);
+    int indexOf(const QString &family);
+    bool refresh(QStringList *families, QSet<QString> *removed);
+
+private:
+    void ensureLoaded();
+    void setFamilies(const QStringList &families);
+
+    QStringList m_families;
+    QHash<QString, int> m_familyToIndex;
+    bool m_loaded;
+};
+
+Q_GLOBAL_STATIC(QtFontFamilyCatalog, fontFamilyCatalog)
+
+void QtFontFamilyCatalog::ensureLoaded()
+{
+    if (!m_loaded)
+        setFamilies(fontDatabase()->families());
+}
+
+void QtFontFamilyCatalog::setFamilies(const QStringList &families)
+{
+    m_loaded = true;
+    m_families = families;
+    m_familyToIndex.clear();
+    m_familyToIndex.reserve(families.count());
+    const int count = families.count();
+    for (int i = 0; i < count; i++) {
+        if (!m_familyToIndex.contains(families.at(i)))
+            m_familyToIndex.insert(families.at(i), i);
+    }
+}
+
+QStringList QtFontFamilyCatalog::families()
+{
+    ensureLoaded();
+    return m_families;
+}
+
+// Whether \a families is the catalog's current list, so that indexOf()
+// applies to it. Cheap for lists obtained from families().
+bool QtFontFamilyCatalog::isCurrent(const QStringList &families)
+{
+    ensureLoaded();
+    return m_families == families;
+}
+
+int QtFontFamilyCatalog::indexOf(const QString &family)
+{
+    ensureLoaded();
+    return m_familyToIndex.value(family, -1);
+}
+
+// Rescans the font database and brings \a families, a list obtained from
+// families() earlier, up to date. Returns whether \a families changed and
+// collects the entries that no longer exist in \a removed. The diff is
+// taken against the caller's list, since another font manager may have
+// rescanned already.
+bool QtFontFamilyCatalog::refresh(QStringList *families, QSet<QString> *removed)
+{
+    const QStringList newFamilies = fontDatabase()->families();
+    if (!m_loaded || newFamilies != m_families)
+        setFamilies(newFamilies);
+    if (*families == m_families)
+        return false;
+
+    for (const QString &family : qAsConst(*families)) {
+        if (!m_familyToIndex.contains(family))
+            removed->insert(family);
+    }
+    *families = m_families;
+    return true;
+}
+
 class QtFontPropertyManagerPrivate
 {
     QtFontPropertyManager *q_ptr;
@@ -5530,7 +6257,9 @@ public:
     void slotFontDatabaseChanged();
     void slotFontDatabaseDelayedChange();
 
-    QStringList m_familyNames;
+    int familyIndex(const QString &family) const;
+
+    QStringList m_familyNames; // the catalog's list as of the last sync
 
     typedef QMap<const QtProperty *, QFont> PropertyValueMap;
     PropertyValueMap m_values;
@@ -5565,6 +6294,13 @@ QtFontPropertyManagerPrivate::QtFontPropertyManagerPrivate() :
 {
 }
 
+int QtFontPropertyManagerPrivate::familyIndex(const QString &family) const
+{
+    QtFontFamilyCatalog *catalog = fontFamilyCatalog();
+    const int idx = catalog->isCurrent(m_familyNames) ? catalog->indexOf(family) : m_familyNames.indexOf(family);
+    return idx == -1 ? 0 : idx;
+}
+
 void QtFontPropertyManagerPrivate::slotIntChanged(QtProperty *property, int value)
 {
     if (m_settingValue)
@@ -5655,22 +6391,39 @@ void  QtFontPropertyManagerPrivate::slotFontDatabaseChanged()
 void QtFontPropertyManagerPrivate::slotFontDatabaseDelayedChange()
 {
     typedef QMap<const QtProperty *, QtProperty *> PropertyPropertyMap;
-    // rescan available font names
+    // rescan available font names; another manager may have done so already
+    QtFontFamilyCatalog *catalog = fontFamilyCatalog();
     const QStringList oldFamilies = m_familyNames;
-    m_familyNames = fontDatabase()->families();
-
-    // Adapt all existing properties
-    if (!m_propertyToFamily.isEmpty()) {
-        PropertyPropertyMap::const_iterator cend = m_propertyToFamily.constEnd();
-        for (PropertyPropertyMap::const_iterator it = m_propertyToFamily.constBegin(); it != cend; ++it) {
-            QtProperty *familyProp = it.value();
-            const int oldIdx = m_enumPropertyManager->value(familyProp);
-            int newIdx = m_familyNames.indexOf(oldFamilies.at(oldIdx));
-            if (newIdx < 0)
-                newIdx = 0;
-            m_enumPropertyManager->setEnumNames(familyProp, m_familyNames);
-            m_enumPropertyManager->setValue(familyProp, newIdx);
-        }
+    QSet<QString> removed;
+    if (!catalog->refresh(&m_familyNames, &removed))
+        return;
+
+    // Adapt all existing properties. They all get the catalog's list, which the
+    // enum manager interns into one shared table. A family that still exists is
+    // looked up by name; only the properties whose family was removed are remapped.
+    QList<QtProperty *> lostFamily;
+    const bool settingValue = m_settingValue;
+    m_settingValue = true;
+    PropertyPropertyMap::const_iterator cend = m_propertyToFamily.constEnd();
+    for (PropertyPropertyMap::const_iterator it = m_propertyToFamily.constBegin(); it != cend; ++it) {
+        QtProperty *familyProp = it.value();
+        if (!familyProp)
+            continue;
+        const QString family = oldFamilies.value(m_enumPropertyManager->value(familyProp));
+        // setEnumNames() selects the first entry
+        m_enumPropertyManager->setEnumNames(familyProp, m_familyNames);
+        if (family.isEmpty() || removed.contains(family))
+            lostFamily.append(m_familyToProperty.value(familyProp));
+        else
+            m_enumPropertyManager->setValue(familyProp, catalog->indexOf(family));
+    }
+    m_settingValue = settingValue;
+
+    // fonts whose family went away follow the family subproperty to the first entry
+    for (QtProperty *property : qAsConst(lostFamily)) {
+        QFont f = m_values.value(property);
+        f.setFamily(m_familyNames.value(0));
+        q_ptr->setValue(property, f);
     }
 }
 
@@ -5847,9 +6600,7 @@ void QtFontPropertyManager::setValue(QtProperty *property, const QFont &val)
 
     it.value() = val;
 
-    int idx = d_ptr->m_familyNames.indexOf(val.family());
-    if (idx == -1)
-        idx = 0;
+    const int idx = d_ptr->familyIndex(val.family());
     bool settingValue = d_ptr->m_settingValue;
     d_ptr->m_settingValue = true;
     d_ptr->m_enumPropertyManager->setValue(d_ptr->m_propertyToFamily[property], idx);
@@ -5861,7 +6612,7 @@ void QtFontPropertyManager::setValue(QtProperty *property, const QFont &val)
     d_ptr->m_boolPropertyManager->setValue(d_ptr->m_propertyToKerning[property], val.kerning());
     d_ptr->m_settingValue = settingValue;
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, val);
 }
 
@@ -5876,12 +6627,9 @@ void QtFontPropertyManager::initializeProperty(QtProperty *property)
     QtProperty *familyProp = d_ptr->m_enumPropertyManager->addProperty();
     familyProp->setPropertyName(tr("Family"));
     if (d_ptr->m_familyNames.isEmpty())
-        d_ptr->m_familyNames = fontDatabase()->families();
+        d_ptr->m_familyNames = fontFamilyCatalog()->families();
     d_ptr->m_enumPropertyManager->setEnumNames(familyProp, d_ptr->m_familyNames);
-    int idx = d_ptr->m_familyNames.indexOf(val.family());
-    if (idx == -1)
-        idx = 0;
-    d_ptr->m_enumPropertyManager->setValue(familyProp, idx);
+    d_ptr->m_enumPropertyManager->setValue(familyProp, d_ptr->familyIndex(val.family()));
     d_ptr->m_propertyToFamily[property] = familyProp;
     d_ptr->m_familyToProperty[familyProp] = property;
     property->addSubProperty(familyProp);
@@ -6188,7 +6936,7 @@ void QtColorPropertyManager::setValue(QtProperty *property, const QColor &val)
     d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToB[property], val.blue());
     d_ptr->m_intPropertyManager->setValue(d_ptr->m_propertyToA[property], val.alpha());
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, val);
 }
 
@@ -6401,7 +7149,7 @@ void QtCursorPropertyManager::setValue(QtProperty *property, const QCursor &valu
 
     it.value() = value;
 
-    emit propertyChanged(property);
+    notifyPropertyChanged(property);
     emit valueChanged(property, value);
 #endif
 }
@@ -48,6 +48,8 @@ class QDate;
 class QTime;
 class QDateTime;
 class QLocale;
+class QBitArray;
+class QRegularExpression;
 
 class QtGroupPropertyManager : public QtAbstractPropertyManager
 {
@@ -108,6 +110,8 @@ public:
 
     bool value(const QtProperty *property) const;
 
+    QtInlineEditing *inlineEditing() const;
+
 public Q_SLOTS:
     void setValue(QtProperty *property, bool val);
 Q_SIGNALS:
@@ -171,13 +175,16 @@ public:
 
     QString value(const QtProperty *property) const;
     QRegExp regExp(const QtProperty *property) const;
+    QRegularExpression regularExpression(const QtProperty *property) const;
 
 public Q_SLOTS:
     void setValue(QtProperty *property, const QString &val);
     void setRegExp(QtProperty *property, const QRegExp &regExp);
+    void setRegularExpression(QtProperty *property, const QRegularExpression &regularExpression);
 Q_SIGNALS:
     void valueChanged(QtProperty *property, const QString &val);
     void regExpChanged(QtProperty *property, const QRegExp &regExp);
+    void regularExpressionChanged(QtProperty *property, const QRegularExpression &regularExpression);
 protected:
     QString valueText(const QtProperty *property) const;
     virtual void initializeProperty(QtProperty *property);
@@ -563,6 +570,8 @@ public:
     QStringList enumNames(const QtProperty *property) const;
     QMap<int, QIcon> enumIcons(const QtProperty *property) const;
 
+    QtInlineEditing *inlineEditing() const;
+
 public Q_SLOTS:
     void setValue(QtProperty *property, int val);
     void setEnumNames(QtProperty *property, const QStringList &names);
@@ -594,18 +603,29 @@ public:
     QtBoolPropertyManager *subBoolPropertyManager() const;
 
     int value(const QtProperty *property) const;
+    QBitArray bitValue(const QtProperty *property) const;
+    bool testFlag(const QtProperty *property, int index) const;
     QStringList flagNames(const QtProperty *property) const;
 
+    bool subPropertiesDeferred() const;
+    void setSubPropertiesDeferred(bool defer);
+    void createSubProperties(QtProperty *property);
+
 public Q_SLOTS:
     void setValue(QtProperty *property, int val);
+    void setBitValue(QtProperty *property, const QBitArray &val);
+    void setFlag(QtProperty *property, int index, bool on);
     void setFlagNames(QtProperty *property, const QStringList &names);
 Q_SIGNALS:
     void valueChanged(QtProperty *property, int val);
+    void bitValueChanged(QtProperty *property, const QBitArray &val);
     void flagNamesChanged(QtProperty *property, const QStringList &names);
 protected:
     QString valueText(const QtProperty *property) const;
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
+    virtual bool hasDeferredSubProperties(const QtProperty *property) const;
+    virtual void createDeferredSubProperties(QtProperty *property);
 private:
     QScopedPointer<QtFlagPropertyManagerPrivate> d_ptr;
     Q_DECLARE_PRIVATE(QtFlagPropertyManager)
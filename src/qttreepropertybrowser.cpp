@@ -39,11 +39,16 @@
 
 #include "qttreepropertybrowser.h"
 #include <QtCore/QSet>
+#include <QtCore/QHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QTimer>
 #include <QtGui/QIcon>
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QItemDelegate>
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QHeaderView>
+#include <QtWidgets/QScrollBar>
+#include <QtWidgets/QMenu>
 #include <QtGui/QPainter>
 #include <QtWidgets/QApplication>
 #include <QtGui/QFocusEvent>
@@ -54,6 +59,59 @@ QT_BEGIN_NAMESPACE
 
 class QtPropertyEditorView;
 
+// Keeps the maximum content width of one column up to date per changed row,
+// so that sizing a column to its contents does not query every row.
+class QtColumnWidthTracker
+{
+public:
+    void setWidth(QTreeWidgetItem *item, int width);
+    void removeItem(QTreeWidgetItem *item);
+    void clear();
+    int maximum() const { return m_widthToCount.isEmpty() ? 0 : m_widthToCount.lastKey(); }
+
+private:
+    void release(int width);
+
+    QHash<QTreeWidgetItem *, int> m_itemToWidth;
+    QMap<int, int> m_widthToCount;
+};
+
+void QtColumnWidthTracker::setWidth(QTreeWidgetItem *item, int width)
+{
+    const auto it = m_itemToWidth.find(item);
+    if (it != m_itemToWidth.end()) {
+        if (it.value() == width)
+            return;
+        release(it.value());
+        it.value() = width;
+    } else {
+        m_itemToWidth.insert(item, width);
+    }
+    ++m_widthToCount[width];
+}
+
+void QtColumnWidthTracker::removeItem(QTreeWidgetItem *item)
+{
+    const auto it = m_itemToWidth.find(item);
+    if (it == m_itemToWidth.end())
+        return;
+    release(it.value());
+    m_itemToWidth.erase(it);
+}
+
+void QtColumnWidthTracker::clear()
+{
+    m_itemToWidth.clear();
+    m_widthToCount.clear();
+}
+
+void QtColumnWidthTracker::release(int width)
+{
+    const auto it = m_widthToCount.find(width);
+    if (--it.value() == 0)
+        m_widthToCount.erase(it);
+}
+
 class QtTreePropertyBrowserPrivate
 {
     QtTreePropertyBrowser *q_ptr;
@@ -68,6 +126,8 @@ public:
     void propertyChanged(QtBrowserItem *index);
     QWidget *createEditor(QtProperty *property, QWidget *parent) const
         { return q_ptr->createEditor(property, parent); }
+    bool hasEditorFactory(QtProperty *property) const
+        { return q_ptr->hasEditorFactory(property); }
     QtProperty *indexToProperty(const QModelIndex &index) const;
     QTreeWidgetItem *indexToItem(const QModelIndex &index) const;
     QtBrowserItem *indexToBrowserItem(const QModelIndex &index) const;
@@ -83,6 +143,7 @@ public:
 
     QtPropertyEditorView *treeWidget() const { return m_treeWidget; }
     bool markPropertiesWithoutValue() const { return m_markPropertiesWithoutValue; }
+    QtTreePropertyBrowser::InlineEditors inlineEditors() const { return m_inlineEditors; }
 
     QtBrowserItem *currentItem() const;
     void setCurrentItem(QtBrowserItem *browserItem, bool block);
@@ -93,6 +154,19 @@ public:
 
     QTreeWidgetItem *editedItem() const;
 
+    typedef QList<QPair<QString, QTreeWidgetItem *> > ItemPathList;
+    void collectItemPaths(QTreeWidgetItem *parentItem, const QString &parentPath, ItemPathList &paths) const;
+    QByteArray saveState() const;
+    bool restoreState(const QByteArray &state);
+
+    void setResizeMode(QtTreePropertyBrowser::ResizeMode mode);
+    void setColumnWidthTracking(bool enable);
+    void updateContentsWidth(QTreeWidgetItem *item);
+    void updateChildContentsWidths(QTreeWidgetItem *item);
+    void updateAllContentsWidths();
+    void slotResizeColumnsToContents();
+    void slotSectionDoubleClicked(int column);
+
 private:
     void updateItem(QTreeWidgetItem *item);
 
@@ -107,8 +181,13 @@ private:
     QtTreePropertyBrowser::ResizeMode m_resizeMode;
     class QtPropertyEditorDelegate *m_delegate;
     bool m_markPropertiesWithoutValue;
+    QtTreePropertyBrowser::InlineEditors m_inlineEditors;
     bool m_browserChangedBlocked;
     QIcon m_expandIcon;
+
+    bool m_trackColumnWidths;
+    QtColumnWidthTracker m_columnWidths[2];
+    QTimer *m_columnResizeTimer;
 };
 
 // ------------ QtPropertyEditorView
@@ -123,6 +202,16 @@ public:
 
     QTreeWidgetItem *indexToItem(const QModelIndex &index) const
         { return itemFromIndex(index); }
+    QModelIndex itemToIndex(QTreeWidgetItem *item, int column) const
+        { return indexFromItem(item, column); }
+
+    // While a delayed layout is pending QTreeView::expand() only records
+    // the expanded state, so a batch of expand/collapse calls bracketed by
+    // these costs a single layout pass.
+    void beginBatchLayout() { scheduleDelayedItemsLayout(); }
+    void endBatchLayout() { executeDelayedItemsLayout(); }
+
+    bool editInline(const QModelIndex &index, const QPoint *pos);
 
 protected:
     void keyPressEvent(QKeyEvent *event);
@@ -137,7 +226,6 @@ QtPropertyEditorView::QtPropertyEditorView(QWidget *parent) :
     QTreeWidget(parent),
     m_editorPrivate(0)
 {
-    connect(header(), SIGNAL(sectionDoubleClicked(int)), this, SLOT(resizeColumnToContents(int)));
 }
 
 void QtPropertyEditorView::drawRow(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
@@ -184,7 +272,8 @@ void QtPropertyEditorView::keyPressEvent(QKeyEvent *event)
                         index = index.sibling(index.row(), 1);
                         setCurrentIndex(index);
                     }
-                    edit(index);
+                    if (!editInline(index, 0))
+                        edit(index);
                     return;
                 }
         break;
@@ -203,7 +292,9 @@ void QtPropertyEditorView::mousePressEvent(QMouseEvent *event)
         if ((item != m_editorPrivate->editedItem()) && (event->button() == Qt::LeftButton)
                 && (header()->logicalIndexAt(event->pos().x()) == 1)
                 && ((item->flags() & (Qt::ItemIsEditable | Qt::ItemIsEnabled)) == (Qt::ItemIsEditable | Qt::ItemIsEnabled))) {
-            editItem(item, 1);
+            const QPoint pos = event->pos();
+            if (!editInline(itemToIndex(item, 1), &pos))
+                editItem(item, 1);
         } else if (!m_editorPrivate->hasValue(item) && m_editorPrivate->markPropertiesWithoutValue() && !rootIsDecorated()) {
             if (event->pos().x() + header()->offset() < 20)
                 item->setExpanded(!item->isExpanded());
@@ -211,6 +302,52 @@ void QtPropertyEditorView::mousePressEvent(QMouseEvent *event)
     }
 }
 
+// ------------ Inline editors
+// Values the delegate paints and edits in place, read and written through
+// the inline editing interface of the manager that created the property.
+
+static QtTreePropertyBrowser::InlineEditor inlineEditorType(const QtProperty *property)
+{
+    if (const QtInlineEditing *editing = property->propertyManager()->inlineEditing()) {
+        switch (editing->inlineValueType(property)) {
+        case QtInlineEditing::BoolValue:
+            return QtTreePropertyBrowser::InlineBoolEditor;
+        case QtInlineEditing::EnumValue:
+            return QtTreePropertyBrowser::InlineEnumEditor;
+        default:
+            break;
+        }
+    }
+    return QtTreePropertyBrowser::NoInlineEditors;
+}
+
+// The following are only called for properties inlineEditorType() accepted.
+
+static inline QVariant inlineValue(const QtProperty *property)
+{
+    return property->propertyManager()->inlineEditing()->inlineValue(property);
+}
+
+static inline bool isInlineValueMixed(const QtProperty *property)
+{
+    return property->propertyManager()->inlineEditing()->isInlineValueMixed(property);
+}
+
+static inline void setInlineValue(QtProperty *property, const QVariant &value)
+{
+    property->propertyManager()->inlineEditing()->setInlineValue(property, value);
+}
+
+static inline QStringList inlineEnumNames(const QtProperty *property)
+{
+    return property->propertyManager()->inlineEditing()->inlineEnumNames(property);
+}
+
+static inline QMap<int, QIcon> inlineEnumIcons(const QtProperty *property)
+{
+    return property->propertyManager()->inlineEditing()->inlineEnumIcons(property);
+}
+
 // ------------ QtPropertyEditorDelegate
 class QtPropertyEditorDelegate : public QItemDelegate
 {
@@ -244,11 +381,19 @@ public:
 
     QTreeWidgetItem *editedItem() const { return m_editedItem; }
 
+    QtTreePropertyBrowser::InlineEditor inlineEditor(const QModelIndex &index) const;
+    bool editInline(const QModelIndex &index, const QStyleOptionViewItem &option, const QPoint *pos);
+
 private slots:
     void slotEditorDestroyed(QObject *object);
+    void slotInlineEnumTriggered(QAction *action);
 
 private:
     int indentation(const QModelIndex &index) const;
+    QRect checkRect(const QStyleOptionViewItem &option) const;
+    QRect arrowRect(const QStyleOptionViewItem &option) const;
+    void paintInline(QtTreePropertyBrowser::InlineEditor type, QPainter *painter,
+            const QStyleOptionViewItem &option, const QModelIndex &index) const;
 
     typedef QMap<QWidget *, QtProperty *> EditorToPropertyMap;
     mutable EditorToPropertyMap m_editorToProperty;
@@ -258,6 +403,8 @@ private:
     QtTreePropertyBrowserPrivate *m_editorPrivate;
     mutable QTreeWidgetItem *m_editedItem;
     mutable QWidget *m_editedWidget;
+    // the index whose enum names the inline menu shows
+    QPersistentModelIndex m_inlineMenuIndex;
 };
 
 int QtPropertyEditorDelegate::indentation(const QModelIndex &index) const
@@ -276,6 +423,150 @@ int QtPropertyEditorDelegate::indentation(const QModelIndex &index) const
     return indent * m_editorPrivate->treeWidget()->indentation();
 }
 
+// Returns the kind of widgetless editor used for the value column of
+// the given index, if any.
+QtTreePropertyBrowser::InlineEditor QtPropertyEditorDelegate::inlineEditor(const QModelIndex &index) const
+{
+    if (index.column() != 1 || !m_editorPrivate || !m_editorPrivate->inlineEditors())
+        return QtTreePropertyBrowser::NoInlineEditors;
+
+    QtProperty *property = m_editorPrivate->indexToProperty(index);
+    if (!property || !property->hasValue())
+        return QtTreePropertyBrowser::NoInlineEditors;
+
+    const QtTreePropertyBrowser::InlineEditor type = inlineEditorType(property);
+    if (!(m_editorPrivate->inlineEditors() & type) || !m_editorPrivate->hasEditorFactory(property))
+        return QtTreePropertyBrowser::NoInlineEditors;
+    return type;
+}
+
+QRect QtPropertyEditorDelegate::checkRect(const QStyleOptionViewItem &option) const
+{
+    const QWidget *widget = option.widget;
+    const QStyle *style = widget ? widget->style() : QApplication::style();
+    const int margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, 0, widget) + 1;
+    const int width = style->pixelMetric(QStyle::PM_IndicatorWidth, &option, widget);
+    const int height = style->pixelMetric(QStyle::PM_IndicatorHeight, &option, widget);
+    const QRect rect(option.rect.x() + margin, option.rect.y() + (option.rect.height() - height) / 2,
+                width, height);
+    return QStyle::visualRect(option.direction, option.rect, rect);
+}
+
+QRect QtPropertyEditorDelegate::arrowRect(const QStyleOptionViewItem &option) const
+{
+    const QWidget *widget = option.widget;
+    const QStyle *style = widget ? widget->style() : QApplication::style();
+    const int width = style->pixelMetric(QStyle::PM_MenuButtonIndicator, &option, widget);
+    const QRect rect(option.rect.right() - width, option.rect.y(), width, option.rect.height());
+    return QStyle::visualRect(option.direction, option.rect, rect);
+}
+
+void QtPropertyEditorDelegate::paintInline(QtTreePropertyBrowser::InlineEditor type, QPainter *painter,
+            const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    const QWidget *widget = option.widget;
+    const QStyle *style = widget ? widget->style() : QApplication::style();
+
+    if (type == QtTreePropertyBrowser::InlineBoolEditor) {
+        // a style drawn check box instead of the value icon, followed by the value text
+        QtProperty *property = m_editorPrivate->indexToProperty(index);
+        const QRect check = checkRect(option);
+        const int margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, 0, widget) + 1;
+        QRect textRect = option.rect;
+        if (option.direction == Qt::LeftToRight)
+            textRect.setLeft(check.right() + margin);
+        else
+            textRect.setRight(check.left() - margin);
+
+        drawBackground(painter, option, index);
+        Qt::CheckState state = inlineValue(property).toBool() ? Qt::Checked : Qt::Unchecked;
+        if (isInlineValueMixed(property))
+            state = Qt::PartiallyChecked;
+        drawCheck(painter, option, check, state);
+        drawDisplay(painter, option, textRect, index.data(Qt::DisplayRole).toString());
+        return;
+    }
+
+    // the regular value cell, narrowed by a drop-down arrow
+    const QRect arrow = arrowRect(option);
+    QStyleOptionViewItem opt = option;
+    if (option.direction == Qt::LeftToRight)
+        opt.rect.setRight(arrow.left() - 1);
+    else
+        opt.rect.setLeft(arrow.right() + 1);
+    drawBackground(painter, option, index);
+    QItemDelegate::paint(painter, opt, index);
+
+    QStyleOption arrowOption;
+    arrowOption.initFrom(widget ? widget : m_editorPrivate->treeWidget());
+    arrowOption.rect = arrow;
+    arrowOption.state = option.state & QStyle::State_Enabled;
+    arrowOption.palette = option.palette;
+    style->drawPrimitive(QStyle::PE_IndicatorArrowDown, &arrowOption, painter, widget);
+}
+
+// Edits the value of the given index without creating an editor widget,
+// returns false if the index has no inline editor. A bool is toggled by a
+// click on its check box or from the keyboard (no position), an enum pops
+// up its names below the cell.
+bool QtPropertyEditorDelegate::editInline(const QModelIndex &index, const QStyleOptionViewItem &option,
+            const QPoint *pos)
+{
+    const QtTreePropertyBrowser::InlineEditor type = inlineEditor(index);
+    if (type == QtTreePropertyBrowser::NoInlineEditors)
+        return false;
+
+    QtProperty *property = m_editorPrivate->indexToProperty(index);
+    QTreeWidgetItem *item = m_editorPrivate->indexToItem(index);
+    if (!(item->flags() & Qt::ItemIsEnabled))
+        return true;
+
+    if (type == QtTreePropertyBrowser::InlineBoolEditor) {
+        if (!pos || checkRect(option).contains(*pos))
+            setInlineValue(property, !inlineValue(property).toBool());
+        return true;
+    }
+
+    const QStringList enumNames = inlineEnumNames(property);
+    const QMap<int, QIcon> enumIcons = inlineEnumIcons(property);
+    const int current = inlineValue(property).toInt();
+    QWidget *viewport = m_editorPrivate->treeWidget()->viewport();
+    // The menu is owned by the viewport, so it goes with the browser, and
+    // deletes itself once closed.
+    QMenu *menu = new QMenu(viewport);
+    connect(menu, SIGNAL(aboutToHide()), menu, SLOT(deleteLater()));
+    QAction *currentAction = 0;
+    for (int i = 0; i < enumNames.count(); ++i) {
+        QAction *action = menu->addAction(enumIcons.value(i), enumNames.at(i));
+        action->setCheckable(true);
+        action->setData(i);
+        if (i == current) {
+            action->setChecked(true);
+            currentAction = action;
+        }
+    }
+    if (menu->isEmpty()) {
+        delete menu;
+        return true;
+    }
+
+    menu->setMinimumWidth(option.rect.width());
+    m_inlineMenuIndex = index;
+    connect(menu, SIGNAL(triggered(QAction*)), this, SLOT(slotInlineEnumTriggered(QAction*)));
+    menu->popup(viewport->mapToGlobal(option.rect.bottomLeft()), currentAction);
+    return true;
+}
+
+void QtPropertyEditorDelegate::slotInlineEnumTriggered(QAction *action)
+{
+    // the property may have gone while the menu was open
+    if (!m_inlineMenuIndex.isValid())
+        return;
+    if (QtProperty *property = m_editorPrivate->indexToProperty(m_inlineMenuIndex))
+        setInlineValue(property, action->data());
+    m_inlineMenuIndex = QPersistentModelIndex();
+}
+
 void QtPropertyEditorDelegate::slotEditorDestroyed(QObject *object)
 {
     if (QWidget *w = qobject_cast<QWidget *>(object)) {
@@ -300,7 +591,7 @@ void QtPropertyEditorDelegate::closeEditor(QtProperty *property)
 QWidget *QtPropertyEditorDelegate::createEditor(QWidget *parent,
         const QStyleOptionViewItem &, const QModelIndex &index) const
 {
-    if (index.column() == 1 && m_editorPrivate) {
+    if (index.column() == 1 && m_editorPrivate && inlineEditor(index) == QtTreePropertyBrowser::NoInlineEditors) {
         QtProperty *property = m_editorPrivate->indexToProperty(index);
         QTreeWidgetItem *item = m_editorPrivate->indexToItem(index);
         if (property && item && (item->flags() & Qt::ItemIsEnabled)) {
@@ -356,7 +647,11 @@ void QtPropertyEditorDelegate::paint(QPainter *painter, const QStyleOptionViewIt
     if (c.isValid())
         painter->fillRect(option.rect, c);
     opt.state &= ~QStyle::State_HasFocus;
-    QItemDelegate::paint(painter, opt, index);
+    const QtTreePropertyBrowser::InlineEditor type = inlineEditor(index);
+    if (type != QtTreePropertyBrowser::NoInlineEditors)
+        paintInline(type, painter, opt, index);
+    else
+        QItemDelegate::paint(painter, opt, index);
 
     opt.palette.setCurrentColorGroup(QPalette::Active);
     QColor color = static_cast<QRgb>(QApplication::style()->styleHint(QStyle::SH_Table_GridLineColor, &opt));
@@ -385,6 +680,14 @@ bool QtPropertyEditorDelegate::eventFilter(QObject *object, QEvent *event)
     return QItemDelegate::eventFilter(object, event);
 }
 
+bool QtPropertyEditorView::editInline(const QModelIndex &index, const QPoint *pos)
+{
+    QStyleOptionViewItem option = viewOptions();
+    option.rect = visualRect(index);
+    option.widget = this;
+    return static_cast<QtPropertyEditorDelegate *>(itemDelegate())->editInline(index, option, pos);
+}
+
 //  -------- QtTreePropertyBrowserPrivate implementation
 QtTreePropertyBrowserPrivate::QtTreePropertyBrowserPrivate() :
     m_treeWidget(0),
@@ -392,7 +695,10 @@ QtTreePropertyBrowserPrivate::QtTreePropertyBrowserPrivate() :
     m_resizeMode(QtTreePropertyBrowser::Stretch),
     m_delegate(0),
     m_markPropertiesWithoutValue(false),
-    m_browserChangedBlocked(false)
+    m_inlineEditors(QtTreePropertyBrowser::NoInlineEditors),
+    m_browserChangedBlocked(false),
+    m_trackColumnWidths(false),
+    m_columnResizeTimer(0)
 {
 }
 
@@ -452,6 +758,12 @@ void QtTreePropertyBrowserPrivate::init(QWidget *parent)
     QObject::connect(m_treeWidget, SIGNAL(collapsed(QModelIndex)), q_ptr, SLOT(slotCollapsed(QModelIndex)));
     QObject::connect(m_treeWidget, SIGNAL(expanded(QModelIndex)), q_ptr, SLOT(slotExpanded(QModelIndex)));
     QObject::connect(m_treeWidget, SIGNAL(currentItemChanged(QTreeWidgetItem*,QTreeWidgetItem*)), q_ptr, SLOT(slotCurrentTreeItemChanged(QTreeWidgetItem*,QTreeWidgetItem*)));
+    QObject::connect(m_treeWidget->header(), SIGNAL(sectionDoubleClicked(int)), q_ptr, SLOT(slotSectionDoubleClicked(int)));
+
+    m_columnResizeTimer = new QTimer(q_ptr);
+    m_columnResizeTimer->setSingleShot(true);
+    m_columnResizeTimer->setInterval(0);
+    QObject::connect(m_columnResizeTimer, SIGNAL(timeout()), q_ptr, SLOT(slotResizeColumnsToContents()));
 }
 
 QtBrowserItem *QtTreePropertyBrowserPrivate::currentItem() const
@@ -563,6 +875,13 @@ void QtTreePropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
         m_treeWidget->setCurrentItem(0);
     }
 
+    if (m_trackColumnWidths) {
+        m_columnWidths[0].removeItem(item);
+        m_columnWidths[1].removeItem(item);
+        if (m_resizeMode == QtTreePropertyBrowser::ResizeToContents)
+            m_columnResizeTimer->start();
+    }
+
     delete item;
 
     m_indexToItem.remove(index);
@@ -591,6 +910,8 @@ void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
         expandIcon = m_expandIcon;
     }
     item->setIcon(0, expandIcon);
+    item->setChildIndicatorPolicy(property->hasDeferredSubProperties()
+            ? QTreeWidgetItem::ShowIndicator : QTreeWidgetItem::DontShowIndicatorWhenChildless);
     item->setFirstColumnSpanned(!property->hasValue());
     const QString descriptionToolTip  = property->descriptionToolTip();
     const QString propertyName = property->propertyName();
@@ -615,9 +936,116 @@ void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
         else
             disableItem(item);
     }
+    updateContentsWidth(item);
     m_treeWidget->viewport()->update();
 }
 
+void QtTreePropertyBrowserPrivate::setResizeMode(QtTreePropertyBrowser::ResizeMode mode)
+{
+    m_resizeMode = mode;
+    QHeaderView::ResizeMode m = QHeaderView::Stretch;
+    switch (mode) {
+        case QtTreePropertyBrowser::Interactive:      m = QHeaderView::Interactive;      break;
+        case QtTreePropertyBrowser::Fixed:            m = QHeaderView::Fixed;            break;
+        // QHeaderView::ResizeToContents would query the size hint of every row
+        // on each layout, the sections are sized from the tracked widths instead.
+        case QtTreePropertyBrowser::ResizeToContents: m = QHeaderView::Fixed;            break;
+        case QtTreePropertyBrowser::Stretch:
+        default:                                      m = QHeaderView::Stretch;          break;
+    }
+    m_treeWidget->header()->setSectionResizeMode(m);
+
+    if (mode == QtTreePropertyBrowser::ResizeToContents) {
+        setColumnWidthTracking(true);
+        slotResizeColumnsToContents();
+    }
+}
+
+void QtTreePropertyBrowserPrivate::setColumnWidthTracking(bool enable)
+{
+    if (m_trackColumnWidths == enable)
+        return;
+    m_trackColumnWidths = enable;
+    if (enable) {
+        updateAllContentsWidths();
+    } else {
+        m_columnWidths[0].clear();
+        m_columnWidths[1].clear();
+    }
+}
+
+void QtTreePropertyBrowserPrivate::updateContentsWidth(QTreeWidgetItem *item)
+{
+    if (!m_trackColumnWidths)
+        return;
+
+    // Only rows that are shown count, as with QHeaderView::ResizeToContents.
+    bool shown = !item->isHidden();
+    int depth = m_treeWidget->rootIsDecorated() ? 1 : 0;
+    for (QTreeWidgetItem *parent = item->parent(); parent; parent = parent->parent()) {
+        shown = shown && parent->isExpanded() && !parent->isHidden();
+        ++depth;
+    }
+    if (!shown) {
+        m_columnWidths[0].removeItem(item);
+        m_columnWidths[1].removeItem(item);
+        if (m_resizeMode == QtTreePropertyBrowser::ResizeToContents)
+            m_columnResizeTimer->start();
+        return;
+    }
+    const int indentation = depth * m_treeWidget->indentation();
+
+    m_columnWidths[0].setWidth(item, indentation + m_treeWidget->sizeHintForIndex(m_treeWidget->itemToIndex(item, 0)).width());
+    if (item->isFirstColumnSpanned())
+        m_columnWidths[1].removeItem(item);
+    else
+        m_columnWidths[1].setWidth(item, m_treeWidget->sizeHintForIndex(m_treeWidget->itemToIndex(item, 1)).width());
+
+    if (m_resizeMode == QtTreePropertyBrowser::ResizeToContents)
+        m_columnResizeTimer->start();
+}
+
+// Updates the descendants of item after it was expanded or collapsed.
+void QtTreePropertyBrowserPrivate::updateChildContentsWidths(QTreeWidgetItem *item)
+{
+    if (!m_trackColumnWidths)
+        return;
+    for (int i = 0; i < item->childCount(); ++i) {
+        QTreeWidgetItem *child = item->child(i);
+        updateContentsWidth(child);
+        updateChildContentsWidths(child);
+    }
+}
+
+void QtTreePropertyBrowserPrivate::updateAllContentsWidths()
+{
+    m_columnWidths[0].clear();
+    m_columnWidths[1].clear();
+    for (auto it = m_itemToIndex.cbegin(), end = m_itemToIndex.cend(); it != end; ++it)
+        updateContentsWidth(it.key());
+}
+
+void QtTreePropertyBrowserPrivate::slotResizeColumnsToContents()
+{
+    m_columnResizeTimer->stop();
+    if (m_resizeMode != QtTreePropertyBrowser::ResizeToContents)
+        return;
+    QHeaderView *header = m_treeWidget->header();
+    for (int column = 0; column < 2; column++)
+        header->resizeSection(column, qMax(m_columnWidths[column].maximum(), header->minimumSectionSize()));
+}
+
+void QtTreePropertyBrowserPrivate::slotSectionDoubleClicked(int column)
+{
+    if (column < 0 || column > 1)
+        return;
+    // the first double click pays for measuring all rows, later ones
+    // only for the rows changed in between
+    setColumnWidthTracking(true);
+    QHeaderView *header = m_treeWidget->header();
+    header->resizeSection(column, qMax(m_columnWidths[column].maximum(), header->minimumSectionSize()));
+}
+
 QColor QtTreePropertyBrowserPrivate::calculatedBackgroundColor(QtBrowserItem *item) const
 {
     QtBrowserItem *i = item;
@@ -635,16 +1063,24 @@ void QtTreePropertyBrowserPrivate::slotCollapsed(const QModelIndex &index)
 {
     QTreeWidgetItem *item = indexToItem(index);
     QtBrowserItem *idx = m_itemToIndex.value(item);
-    if (item)
+    if (item) {
+        updateChildContentsWidths(item);
         emit q_ptr->collapsed(idx);
+    }
 }
 
 void QtTreePropertyBrowserPrivate::slotExpanded(const QModelIndex &index)
 {
     QTreeWidgetItem *item = indexToItem(index);
     QtBrowserItem *idx = m_itemToIndex.value(item);
-    if (item)
+    if (item) {
+        if (idx && idx->property()->hasDeferredSubProperties()) {
+            idx->property()->createDeferredSubProperties();
+            item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
+        }
+        updateChildContentsWidths(item);
         emit q_ptr->expanded(idx);
+    }
 }
 
 void QtTreePropertyBrowserPrivate::slotCurrentBrowserItemChanged(QtBrowserItem *item)
@@ -674,6 +1110,99 @@ void QtTreePropertyBrowserPrivate::editItem(QtBrowserItem *browserItem)
     }
 }
 
+// Segment separators of the property paths used as keys in saved states.
+static const QChar pathSeparator = QChar(0x1f);
+static const QChar occurrenceSeparator = QChar(0x1e);
+
+static const quint32 stateMarker = 0x51545042; // "QTPB"
+static const int stateVersion = 1;
+
+void QtTreePropertyBrowserPrivate::collectItemPaths(QTreeWidgetItem *parentItem,
+            const QString &parentPath, ItemPathList &paths) const
+{
+    const int count = parentItem ? parentItem->childCount() : m_treeWidget->topLevelItemCount();
+    QHash<QString, int> nameToOccurrence;
+    for (int i = 0; i < count; i++) {
+        QTreeWidgetItem *item = parentItem ? parentItem->child(i) : m_treeWidget->topLevelItem(i);
+        const QtBrowserItem *browserItem = m_itemToIndex.value(item);
+        if (!browserItem)
+            continue;
+        const QString name = browserItem->property()->propertyName();
+        QString path = parentPath;
+        if (parentItem)
+            path += pathSeparator;
+        path += name;
+        // siblings sharing a name are told apart by their order
+        const int occurrence = nameToOccurrence[name]++;
+        if (occurrence)
+            path += occurrenceSeparator + QString::number(occurrence);
+        paths.append(qMakePair(path, item));
+        if (item->childCount())
+            collectItemPaths(item, path, paths);
+    }
+}
+
+QByteArray QtTreePropertyBrowserPrivate::saveState() const
+{
+    ItemPathList paths;
+    collectItemPaths(0, QString(), paths);
+
+    QHash<QString, bool> pathToExpanded;
+    QString currentPath;
+    QTreeWidgetItem *current = m_treeWidget->currentItem();
+    for (const auto &path : qAsConst(paths)) {
+        if (path.second->childCount())
+            pathToExpanded.insert(path.first, path.second->isExpanded());
+        if (path.second == current)
+            currentPath = path.first;
+    }
+
+    QByteArray state;
+    QDataStream stream(&state, QIODevice::WriteOnly);
+    stream << stateMarker << stateVersion << pathToExpanded << currentPath
+           << m_treeWidget->verticalScrollBar()->value()
+           << m_treeWidget->horizontalScrollBar()->value();
+    return state;
+}
+
+bool QtTreePropertyBrowserPrivate::restoreState(const QByteArray &state)
+{
+    QDataStream stream(state);
+    quint32 marker;
+    int version;
+    stream >> marker >> version;
+    if (stream.status() != QDataStream::Ok || marker != stateMarker || version != stateVersion)
+        return false;
+
+    QHash<QString, bool> pathToExpanded;
+    QString currentPath;
+    int verticalValue;
+    int horizontalValue;
+    stream >> pathToExpanded >> currentPath >> verticalValue >> horizontalValue;
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    ItemPathList paths;
+    collectItemPaths(0, QString(), paths);
+
+    QTreeWidgetItem *current = 0;
+    m_treeWidget->beginBatchLayout();
+    for (const auto &path : qAsConst(paths)) {
+        const auto it = pathToExpanded.constFind(path.first);
+        if (it != pathToExpanded.constEnd())
+            path.second->setExpanded(it.value());
+        if (!current && path.first == currentPath)
+            current = path.second;
+    }
+    m_treeWidget->endBatchLayout();
+
+    if (current)
+        m_treeWidget->setCurrentItem(current);
+    m_treeWidget->verticalScrollBar()->setValue(verticalValue);
+    m_treeWidget->horizontalScrollBar()->setValue(horizontalValue);
+    return true;
+}
+
 /*!
     \class QtTreePropertyBrowser
     \internal
@@ -758,6 +1287,8 @@ int QtTreePropertyBrowser::indentation() const
 void QtTreePropertyBrowser::setIndentation(int i)
 {
     d_ptr->m_treeWidget->setIndentation(i);
+    if (d_ptr->m_trackColumnWidths)
+        d_ptr->updateAllContentsWidths();
 }
 
 /*!
@@ -777,6 +1308,8 @@ void QtTreePropertyBrowser::setRootIsDecorated(bool show)
         if (!property->hasValue())
             d_ptr->updateItem(it.key());
     }
+    if (d_ptr->m_trackColumnWidths)
+        d_ptr->updateAllContentsWidths();
 }
 
 /*!
@@ -826,8 +1359,10 @@ void QtTreePropertyBrowser::setHeaderVisible(bool visible)
   \value Stretch QHeaderView will automatically resize the section to fill the available space.
   The size cannot be changed by the user or programmatically.
 
-  \value ResizeToContents QHeaderView will automatically resize the section to its optimal
-  size based on the contents of the entire column.
+  \value ResizeToContents The section will automatically be resized to its optimal
+  size based on the contents of the entire column. The content widths are
+  measured when rows are inserted or changed, so resizing costs do not grow with
+  the number of rows.
   The size cannot be changed by the user or programmatically.
 
   \sa setResizeMode()
@@ -848,16 +1383,7 @@ void QtTreePropertyBrowser::setResizeMode(QtTreePropertyBrowser::ResizeMode mode
     if (d_ptr->m_resizeMode == mode)
         return;
 
-    d_ptr->m_resizeMode = mode;
-    QHeaderView::ResizeMode m = QHeaderView::Stretch;
-    switch (mode) {
-        case QtTreePropertyBrowser::Interactive:      m = QHeaderView::Interactive;      break;
-        case QtTreePropertyBrowser::Fixed:            m = QHeaderView::Fixed;            break;
-        case QtTreePropertyBrowser::ResizeToContents: m = QHeaderView::ResizeToContents; break;
-        case QtTreePropertyBrowser::Stretch:
-        default:                                      m = QHeaderView::Stretch;          break;
-    }
-    d_ptr->m_treeWidget->header()->setSectionResizeMode(m);
+    d_ptr->setResizeMode(mode);
 }
 
 /*!
@@ -925,8 +1451,11 @@ bool QtTreePropertyBrowser::isItemVisible(QtBrowserItem *item) const
 
 void QtTreePropertyBrowser::setItemVisible(QtBrowserItem *item, bool visible)
 {
-    if (QTreeWidgetItem *treeItem = d_ptr->m_indexToItem.value(item))
+    if (QTreeWidgetItem *treeItem = d_ptr->m_indexToItem.value(item)) {
         treeItem->setHidden(!visible);
+        d_ptr->updateContentsWidth(treeItem);
+        d_ptr->updateChildContentsWidths(treeItem);
+    }
 }
 
 /*!
@@ -999,6 +1528,49 @@ bool QtTreePropertyBrowser::propertiesWithoutValueMarked() const
     return d_ptr->m_markPropertiesWithoutValue;
 }
 
+/*!
+    \enum QtTreePropertyBrowser::InlineEditor
+
+    The kinds of values that can be edited without an editor widget.
+
+    \value NoInlineEditors All values are edited by the widgets the editor factories create.
+    \value InlineBoolEditor Bool values are shown as a check box painted by the
+            browser; clicking it or pressing Space toggles the value.
+    \value InlineEnumEditor Enum values are shown with a painted drop-down arrow;
+            clicking the value pops up the list of names.
+
+    \sa inlineEditors
+*/
+
+/*!
+    \property QtTreePropertyBrowser::inlineEditors
+    \brief the kinds of values edited in place, without an editor widget.
+
+    Bool and enum properties whose manager provides
+    QtAbstractPropertyManager::inlineEditing(), such as
+    QtBoolPropertyManager, QtEnumPropertyManager and
+    QtVariantPropertyManager, are painted and hit-tested by the browser
+    itself when their kind is set, so editing them creates no widget.
+    They still need an editor factory to be editable at all.
+
+    The default is NoInlineEditors.
+
+    \sa setFactoryForManager()
+*/
+QtTreePropertyBrowser::InlineEditors QtTreePropertyBrowser::inlineEditors() const
+{
+    return d_ptr->m_inlineEditors;
+}
+
+void QtTreePropertyBrowser::setInlineEditors(InlineEditors editors)
+{
+    if (d_ptr->m_inlineEditors == editors)
+        return;
+
+    d_ptr->m_inlineEditors = editors;
+    d_ptr->m_treeWidget->viewport()->update();
+}
+
 /*!
     \reimp
 */
@@ -1023,6 +1595,47 @@ void QtTreePropertyBrowser::itemChanged(QtBrowserItem *item)
     d_ptr->propertyChanged(item);
 }
 
+/*!
+    \reimp
+
+    The tree browser shows properties with deferred subproperties as
+    expandable and creates the subproperties when the item is expanded.
+*/
+bool QtTreePropertyBrowser::createsSubPropertiesOnExpand() const
+{
+    return true;
+}
+
+/*!
+    Saves the expanded state of the items, the current item and the
+    scroll position of the browser.
+
+    Items are identified by the path of property names leading to
+    them, so the state can be restored after the properties have been
+    recreated, e.g. when the browser is repopulated for another object
+    of the same type.
+
+    \sa restoreState()
+*/
+QByteArray QtTreePropertyBrowser::saveState() const
+{
+    return d_ptr->saveState();
+}
+
+/*!
+    Restores the \a state previously saved by saveState(). Items whose
+    property path is not part of the state keep their expanded state.
+    All items are expanded or collapsed within a single layout pass.
+
+    Returns true if the state was restored; otherwise returns false.
+
+    \sa saveState()
+*/
+bool QtTreePropertyBrowser::restoreState(const QByteArray &state)
+{
+    return d_ptr->restoreState(state);
+}
+
 /*!
     Sets the current item to \a item and opens the relevant editor for it.
 */
@@ -57,6 +57,7 @@ class QtTreePropertyBrowser : public QtAbstractPropertyBrowser
     Q_PROPERTY(ResizeMode resizeMode READ resizeMode WRITE setResizeMode)
     Q_PROPERTY(int splitterPosition READ splitterPosition WRITE setSplitterPosition)
     Q_PROPERTY(bool propertiesWithoutValueMarked READ propertiesWithoutValueMarked WRITE setPropertiesWithoutValueMarked)
+    Q_PROPERTY(InlineEditors inlineEditors READ inlineEditors WRITE setInlineEditors)
 public:
 
     enum ResizeMode
@@ -68,6 +69,15 @@ public:
     };
     Q_ENUM(ResizeMode)
 
+    enum InlineEditor
+    {
+        NoInlineEditors = 0x0,
+        InlineBoolEditor = 0x1,
+        InlineEnumEditor = 0x2
+    };
+    Q_DECLARE_FLAGS(InlineEditors, InlineEditor)
+    Q_FLAG(InlineEditors)
+
     QtTreePropertyBrowser(QWidget *parent = 0);
     ~QtTreePropertyBrowser();
 
@@ -102,8 +112,14 @@ public:
     void setPropertiesWithoutValueMarked(bool mark);
     bool propertiesWithoutValueMarked() const;
 
+    InlineEditors inlineEditors() const;
+    void setInlineEditors(InlineEditors editors);
+
     void editItem(QtBrowserItem *item);
 
+    QByteArray saveState() const;
+    bool restoreState(const QByteArray &state);
+
 Q_SIGNALS:
 
     void collapsed(QtBrowserItem *item);
@@ -113,6 +129,7 @@ protected:
     virtual void itemInserted(QtBrowserItem *item, QtBrowserItem *afterItem);
     virtual void itemRemoved(QtBrowserItem *item);
     virtual void itemChanged(QtBrowserItem *item);
+    virtual bool createsSubPropertiesOnExpand() const;
 
 private:
 
@@ -124,9 +141,13 @@ private:
     Q_PRIVATE_SLOT(d_func(), void slotExpanded(const QModelIndex &))
     Q_PRIVATE_SLOT(d_func(), void slotCurrentBrowserItemChanged(QtBrowserItem *))
     Q_PRIVATE_SLOT(d_func(), void slotCurrentTreeItemChanged(QTreeWidgetItem *, QTreeWidgetItem *))
+    Q_PRIVATE_SLOT(d_func(), void slotResizeColumnsToContents())
+    Q_PRIVATE_SLOT(d_func(), void slotSectionDoubleClicked(int))
 
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(QtTreePropertyBrowser::InlineEditors)
+
 QT_END_NAMESPACE
 
 #endif
@@ -40,7 +40,9 @@
 #include "qtvariantproperty.h"
 #include "qtpropertymanager.h"
 #include "qteditorfactory.h"
+#include "qtpropertybrowserutils_p.h"
 #include <QtCore/QVariant>
+#include <QtCore/QHash>
 #include <QtGui/QIcon>
 #include <QtCore/QDate>
 #include <QtCore/QLocale>
@@ -128,7 +130,7 @@ int QtVariantPropertyManager::iconMapTypeId()
     return qMetaTypeId<QtIconMap>();
 }
 
-typedef QMap<const QtProperty *, QtProperty *> PropertyMap;
+typedef QHash<const QtProperty *, QtProperty *> PropertyMap;
 Q_GLOBAL_STATIC(PropertyMap, propertyToWrappedProperty)
 
 static QtProperty *wrappedProperty(QtProperty *property)
@@ -144,6 +146,50 @@ public:
     QtVariantPropertyManager *manager;
 };
 
+/*!
+    \class QtVariantValueSource
+    \inmodule QtDesigner
+
+    \brief The QtVariantValueSource class is the interface through which
+    a QtVariantPropertyManager reads and writes values kept in the
+    application's own storage.
+
+    Instead of pushing every change into the manager, an application
+    binds properties to a source with
+    QtVariantPropertyManager::setValueSource(). The manager then pulls
+    values on demand with value(), and writes edits with setValue().
+
+    version() returns a counter that must change whenever the value of
+    the given property may have changed. The manager compares it with
+    the version it last read to skip unchanged values.
+
+    \sa QtVariantPropertyManager::updateValues()
+*/
+
+/*!
+    \fn QtVariantValueSource::~QtVariantValueSource()
+
+    Destroys the source.
+*/
+
+/*!
+    \fn QVariant QtVariantValueSource::value(const QtProperty *property) const
+
+    Returns the current value of the given \a property.
+*/
+
+/*!
+    \fn void QtVariantValueSource::setValue(QtProperty *property, const QVariant &value)
+
+    Stores \a value as the new value of the given \a property.
+*/
+
+/*!
+    \fn uint QtVariantValueSource::version(const QtProperty *property) const
+
+    Returns the version of the given \a property's value.
+*/
+
 /*!
     \class QtVariantProperty
     \internal
@@ -276,13 +322,20 @@ void QtVariantProperty::setAttribute(const QString &attribute, const QVariant &v
     d_ptr->manager->setAttribute(this, attribute, value);
 }
 
-class QtVariantPropertyManagerPrivate
+class QtVariantPropertyManagerPrivate : public QtInlineEditing
 {
     QtVariantPropertyManager *q_ptr;
     Q_DECLARE_PUBLIC(QtVariantPropertyManager)
 public:
     QtVariantPropertyManagerPrivate();
 
+    ValueType inlineValueType(const QtProperty *property) const;
+    QVariant inlineValue(const QtProperty *property) const { return q_ptr->value(property); }
+    void setInlineValue(QtProperty *property, const QVariant &value) { q_ptr->setValue(property, value); }
+    bool isInlineValueMixed(const QtProperty *property) const { return q_ptr->isMixed(property); }
+    QStringList inlineEnumNames(const QtProperty *property) const;
+    QMap<int, QIcon> inlineEnumIcons(const QtProperty *property) const;
+
     bool m_creatingProperty;
     bool m_creatingSubProperties;
     bool m_destroyingSubProperties;
@@ -326,6 +379,7 @@ public:
     void slotFlagNamesChanged(QtProperty *property, const QStringList &flagNames);
     void slotPropertyInserted(QtProperty *property, QtProperty *parent, QtProperty *after);
     void slotPropertyRemoved(QtProperty *property, QtProperty *parent);
+    void slotNotifyPulledSubProperties();
 
     void valueChanged(QtProperty *property, const QVariant &val);
 
@@ -333,17 +387,45 @@ public:
     QtVariantProperty *createSubProperty(QtVariantProperty *parent, QtVariantProperty *after,
             QtProperty *internal);
     void removeSubProperty(QtVariantProperty *property);
+    void updateMixedSubProperties(QtProperty *property);
+    void resolveMixedSubProperty(QtProperty *property, QtProperty *subProperty);
 
     QMap<int, QtAbstractPropertyManager *> m_typeToPropertyManager;
     QMap<int, QMap<QString, int> > m_typeToAttributeToAttributeType;
 
-    QMap<const QtProperty *, QPair<QtVariantProperty *, int> > m_propertyToType;
+    QHash<const QtProperty *, QPair<QtVariantProperty *, int> > m_propertyToType;
 
     QMap<int, int> m_typeToValueType;
 
 
     QMap<QtProperty *, QtVariantProperty *> m_internalToProperty;
 
+    struct MultiValue
+    {
+        MultiValue() : mixed(false) {}
+        QVector<QVariant> values;
+        bool mixed;
+    };
+    QHash<const QtProperty *, MultiValue> m_propertyToValues;
+    // subproperties whose component differs across the values bound to
+    // their parent, mapped to that parent
+    QHash<const QtProperty *, QtProperty *> m_mixedSubProperties;
+    bool m_bindingValues;
+
+    struct SourceBinding
+    {
+        SourceBinding() : source(0), version(0), stale(true) {}
+        QtVariantValueSource *source;
+        uint version;
+        bool stale;
+    };
+    QHash<const QtProperty *, SourceBinding> m_propertyToSource;
+    const QtProperty *m_pullingProperty;
+    // subproperties changed by a pull, refreshed once the read is over
+    QList<QtProperty *> m_pulledSubProperties;
+
+    void pullValue(const QtProperty *property);
+
     const QString m_constraintAttribute;
     const QString m_singleStepAttribute;
     const QString m_decimalsAttribute;
@@ -356,6 +438,8 @@ public:
 };
 
 QtVariantPropertyManagerPrivate::QtVariantPropertyManagerPrivate() :
+    m_bindingValues(false),
+    m_pullingProperty(0),
     m_constraintAttribute(QLatin1String("constraint")),
     m_singleStepAttribute(QLatin1String("singleStep")),
     m_decimalsAttribute(QLatin1String("decimals")),
@@ -368,6 +452,46 @@ QtVariantPropertyManagerPrivate::QtVariantPropertyManagerPrivate() :
 {
 }
 
+QtInlineEditing::ValueType QtVariantPropertyManagerPrivate::inlineValueType(const QtProperty *property) const
+{
+    const int type = q_ptr->propertyType(property);
+    if (type == QVariant::Bool)
+        return BoolValue;
+    if (type == QtVariantPropertyManager::enumTypeId())
+        return EnumValue;
+    return NoInlineValue;
+}
+
+QStringList QtVariantPropertyManagerPrivate::inlineEnumNames(const QtProperty *property) const
+{
+    return q_ptr->attributeValue(property, m_enumNamesAttribute).toStringList();
+}
+
+QMap<int, QIcon> QtVariantPropertyManagerPrivate::inlineEnumIcons(const QtProperty *property) const
+{
+    return qvariant_cast<QtIconMap>(q_ptr->attributeValue(property, m_enumIconsAttribute));
+}
+
+void QtVariantPropertyManagerPrivate::pullValue(const QtProperty *property)
+{
+    if (m_propertyToSource.isEmpty())
+        return;
+
+    const auto it = m_propertyToSource.find(property);
+    if (it == m_propertyToSource.end() || !it.value().stale)
+        return;
+
+    it.value().stale = false;
+    QtVariantValueSource *source = it.value().source;
+    it.value().version = source->version(property);
+    const QVariant val = source->value(property);
+
+    const QtProperty *wasPulling = m_pullingProperty;
+    m_pullingProperty = property;
+    q_ptr->setValue(const_cast<QtProperty *>(property), val);
+    m_pullingProperty = wasPulling;
+}
+
 int QtVariantPropertyManagerPrivate::internalPropertyToType(QtProperty *property) const
 {
     int type = 0;
@@ -438,6 +562,17 @@ void QtVariantPropertyManagerPrivate::slotPropertyInserted(QtProperty *property,
     }
 
     createSubProperty(varParent, varAfter, property);
+    // subproperties created on demand, such as flags, can be mixed already
+    if (m_propertyToValues.contains(varParent))
+        updateMixedSubProperties(varParent);
+}
+
+void QtVariantPropertyManagerPrivate::slotNotifyPulledSubProperties()
+{
+    const QList<QtProperty *> pulled = m_pulledSubProperties;
+    m_pulledSubProperties.clear();
+    for (QtProperty *property : pulled)
+        q_ptr->notifyPropertyChanged(property);
 }
 
 void QtVariantPropertyManagerPrivate::slotPropertyRemoved(QtProperty *property, QtProperty *parent)
@@ -451,13 +586,273 @@ void QtVariantPropertyManagerPrivate::slotPropertyRemoved(QtProperty *property,
     removeSubProperty(varProperty);
 }
 
+// Returns the components of \a value in the order of the subproperties
+// that edit them, for the types whose components are edited as
+// subproperties, and an empty vector for other types. Flags have one
+// component per bit.
+static QVector<QVariant> valueComponents(int propertyType, const QVariant &value)
+{
+    QVector<QVariant> components;
+    if (propertyType == QtVariantPropertyManager::flagTypeId()) {
+        const uint flags = value.toUInt();
+        components.reserve(32);
+        for (int i = 0; i < 32; i++)
+            components.append(bool(flags & (1u << i)));
+        return components;
+    }
+
+    switch (propertyType) {
+    case QVariant::Point: {
+        const QPoint p = value.toPoint();
+        components << p.x() << p.y();
+        break;
+    }
+    case QVariant::PointF: {
+        const QPointF p = value.toPointF();
+        components << p.x() << p.y();
+        break;
+    }
+    case QVariant::Size: {
+        const QSize s = value.toSize();
+        components << s.width() << s.height();
+        break;
+    }
+    case QVariant::SizeF: {
+        const QSizeF s = value.toSizeF();
+        components << s.width() << s.height();
+        break;
+    }
+    case QVariant::Rect: {
+        const QRect r = value.toRect();
+        components << r.x() << r.y() << r.width() << r.height();
+        break;
+    }
+    case QVariant::RectF: {
+        const QRectF r = value.toRectF();
+        components << r.x() << r.y() << r.width() << r.height();
+        break;
+    }
+    case QVariant::Color: {
+        const QColor c = qvariant_cast<QColor>(value);
+        components << c.red() << c.green() << c.blue() << c.alpha();
+        break;
+    }
+    case QVariant::SizePolicy: {
+        const QSizePolicy sp = qvariant_cast<QSizePolicy>(value);
+        components << int(sp.horizontalPolicy()) << int(sp.verticalPolicy())
+                   << sp.horizontalStretch() << sp.verticalStretch();
+        break;
+    }
+    case QVariant::Font: {
+        const QFont f = qvariant_cast<QFont>(value);
+        components << f.family() << f.pointSize() << f.bold() << f.italic()
+                   << f.underline() << f.strikeOut() << f.kerning();
+        break;
+    }
+    case QVariant::Locale: {
+        const QLocale l = value.toLocale();
+        components << int(l.language()) << int(l.country());
+        break;
+    }
+    default:
+        break;
+    }
+    return components;
+}
+
+// The reverse of valueComponents(): returns \a target with its components
+// replaced by \a components. Attributes of \a target that are not edited
+// as subproperties, such as a font's pixel size, are kept.
+static QVariant setValueComponents(int propertyType, const QVariant &target,
+            const QVector<QVariant> &components)
+{
+    if (propertyType == QtVariantPropertyManager::flagTypeId()) {
+        uint flags = 0;
+        for (int i = 0; i < components.count(); i++) {
+            if (components.at(i).toBool())
+                flags |= 1u << i;
+        }
+        return int(flags);
+    }
+
+    const QVector<QVariant> &c = components;
+    switch (propertyType) {
+    case QVariant::Point:
+        return QPoint(c.at(0).toInt(), c.at(1).toInt());
+    case QVariant::PointF:
+        return QPointF(c.at(0).toDouble(), c.at(1).toDouble());
+    case QVariant::Size:
+        return QSize(c.at(0).toInt(), c.at(1).toInt());
+    case QVariant::SizeF:
+        return QSizeF(c.at(0).toDouble(), c.at(1).toDouble());
+    case QVariant::Rect:
+        return QRect(c.at(0).toInt(), c.at(1).toInt(), c.at(2).toInt(), c.at(3).toInt());
+    case QVariant::RectF:
+        return QRectF(c.at(0).toDouble(), c.at(1).toDouble(), c.at(2).toDouble(), c.at(3).toDouble());
+    case QVariant::Color:
+        return QColor(c.at(0).toInt(), c.at(1).toInt(), c.at(2).toInt(), c.at(3).toInt());
+    case QVariant::SizePolicy: {
+        QSizePolicy sp = qvariant_cast<QSizePolicy>(target);
+        sp.setHorizontalPolicy(QSizePolicy::Policy(c.at(0).toInt()));
+        sp.setVerticalPolicy(QSizePolicy::Policy(c.at(1).toInt()));
+        sp.setHorizontalStretch(c.at(2).toInt());
+        sp.setVerticalStretch(c.at(3).toInt());
+        return QVariant::fromValue(sp);
+    }
+    case QVariant::Font: {
+        QFont f = qvariant_cast<QFont>(target);
+        f.setFamily(c.at(0).toString());
+        if (c.at(1).toInt() > 0)
+            f.setPointSize(c.at(1).toInt());
+        f.setBold(c.at(2).toBool());
+        f.setItalic(c.at(3).toBool());
+        f.setUnderline(c.at(4).toBool());
+        f.setStrikeOut(c.at(5).toBool());
+        f.setKerning(c.at(6).toBool());
+        return f;
+    }
+    case QVariant::Locale:
+        return QLocale(QLocale::Language(c.at(0).toInt()), QLocale::Country(c.at(1).toInt()));
+    default:
+        break;
+    }
+    return target;
+}
+
+// Applies the components in which \a current differs from \a previous to
+// \a target, for the types whose components are edited as subproperties.
+// Other values replace \a target as a whole.
+static QVariant mergeComponents(int propertyType, const QVariant &target,
+            const QVector<QVariant> &previous, const QVariant &current)
+{
+    const QVector<QVariant> currentComponents = valueComponents(propertyType, current);
+    if (currentComponents.isEmpty())
+        return current;
+
+    QVector<QVariant> components = valueComponents(propertyType, target);
+    for (int i = 0; i < components.count(); i++) {
+        if (currentComponents.at(i) != previous.at(i))
+            components[i] = currentComponents.at(i);
+    }
+    return setValueComponents(propertyType, target, components);
+}
+
+// Marks the subproperties of \a property whose component differs across
+// the bound values as mixed, so that they show the placeholder too.
+void QtVariantPropertyManagerPrivate::updateMixedSubProperties(QtProperty *property)
+{
+    const QList<QtProperty *> subProperties = property->subProperties();
+    QVector<bool> mixed(subProperties.count(), false);
+
+    const auto it = m_propertyToValues.constFind(property);
+    if (it != m_propertyToValues.constEnd() && it.value().mixed) {
+        const int type = m_propertyToType.value(property).second;
+        const QVector<QVariant> &values = it.value().values;
+        const QVector<QVariant> first = valueComponents(type, values.first());
+        const int count = qMin(mixed.count(), first.count());
+        for (int k = 1; k < values.count(); k++) {
+            const QVector<QVariant> components = valueComponents(type, values.at(k));
+            for (int i = 0; i < count; i++) {
+                if (components.at(i) != first.at(i))
+                    mixed[i] = true;
+            }
+        }
+    }
+
+    for (int i = 0; i < subProperties.count(); i++) {
+        QtProperty *subProperty = subProperties.at(i);
+        if (mixed.at(i) == m_mixedSubProperties.contains(subProperty))
+            continue;
+        if (mixed.at(i))
+            m_mixedSubProperties.insert(subProperty, property);
+        else
+            m_mixedSubProperties.remove(subProperty);
+        q_ptr->notifyPropertyChanged(subProperty);
+    }
+}
+
+// Writes the component that \a subProperty edits, as held by the first
+// bound value, to all values bound to \a property.
+void QtVariantPropertyManagerPrivate::resolveMixedSubProperty(QtProperty *property, QtProperty *subProperty)
+{
+    const auto it = m_propertyToValues.find(property);
+    const int index = property->subProperties().indexOf(subProperty);
+    if (it == m_propertyToValues.end() || index < 0)
+        return;
+
+    MultiValue &multiValue = it.value();
+    const int type = m_propertyToType.value(property).second;
+    const QVector<QVariant> first = valueComponents(type, multiValue.values.first());
+    if (index >= first.count())
+        return;
+    for (QVariant &value : multiValue.values) {
+        QVector<QVariant> components = valueComponents(type, value);
+        components[index] = first.at(index);
+        value = setValueComponents(type, value, components);
+    }
+    multiValue.mixed = !qtIsUniform(multiValue.values.constData(),
+                multiValue.values.constData() + multiValue.values.count());
+    emit q_ptr->valuesChanged(property, multiValue.values);
+    q_ptr->notifyPropertyChanged(property);
+    updateMixedSubProperties(property);
+}
+
 void QtVariantPropertyManagerPrivate::valueChanged(QtProperty *property, const QVariant &val)
 {
     QtVariantProperty *varProp = m_internalToProperty.value(property, 0);
     if (!varProp)
         return;
+
+    // A value read from the source is neither written back nor announced
+    // again. Pulls happen while browsers read values, typically while
+    // painting, so the subproperties it changes are refreshed later.
+    if (m_pullingProperty) {
+        if (varProp != m_pullingProperty && !m_pulledSubProperties.contains(varProp)) {
+            if (m_pulledSubProperties.isEmpty())
+                QMetaObject::invokeMethod(q_ptr, "slotNotifyPulledSubProperties", Qt::QueuedConnection);
+            m_pulledSubProperties.append(varProp);
+        }
+        return;
+    }
+
+    const auto itSource = m_propertyToSource.find(varProp);
+    if (itSource != m_propertyToSource.end()) {
+        QtVariantValueSource *source = itSource.value().source;
+        // a source that adjusts the written value bumps the version, which
+        // makes the next updateValues() read the adjusted value back
+        const uint version = source->version(varProp);
+        source->setValue(varProp, val);
+        // the source may have been rebound or rehashed by the write
+        const auto itWritten = m_propertyToSource.find(varProp);
+        if (itWritten != m_propertyToSource.end() && itWritten.value().source == source) {
+            itWritten.value().version = version;
+            itWritten.value().stale = false;
+        }
+    }
+
     emit q_ptr->valueChanged(varProp, val);
-    emit q_ptr->propertyChanged(varProp);
+
+    // a change of a property bound to several values writes through to all
+    // of them; of mixed compound values only the edited components change
+    const auto it = m_propertyToValues.find(varProp);
+    if (it != m_propertyToValues.end() && !m_bindingValues) {
+        MultiValue &multiValue = it.value();
+        if (multiValue.mixed) {
+            const int type = m_propertyToType.value(varProp).second;
+            const QVector<QVariant> previous = valueComponents(type, multiValue.values.first());
+            for (QVariant &value : multiValue.values)
+                value = mergeComponents(type, value, previous, val);
+            multiValue.mixed = !qtIsUniform(multiValue.values.constData(),
+                        multiValue.values.constData() + multiValue.values.count());
+        } else {
+            multiValue.values.fill(val);
+        }
+        emit q_ptr->valuesChanged(varProp, multiValue.values);
+        q_ptr->notifyPropertyChanged(varProp);
+        updateMixedSubProperties(varProp);
+        return;
+    }
+    q_ptr->notifyPropertyChanged(varProp);
 }
 
 void QtVariantPropertyManagerPrivate::slotValueChanged(QtProperty *property, int val)
@@ -892,6 +1287,21 @@ void QtVariantPropertyManagerPrivate::slotFlagNamesChanged(QtProperty *property,
     \sa setValue()
 */
 
+/*!
+    \fn void QtVariantPropertyManager::valuesChanged(QtProperty *property, const QVector<QVariant> &values)
+
+    This signal is emitted whenever a property bound to several values
+    with setValues() is given a new value, passing a pointer to the
+    \a property and the updated \a values as parameters. All entries
+    of \a values are equal; writing them to the bound objects applies
+    the change to the whole selection in one batch.
+
+    The signal is emitted after valueChanged(), and not at all for
+    the values pushed by setValues() itself.
+
+    \sa setValues(), isMixed()
+*/
+
 /*!
     \fn void QtVariantPropertyManager::attributeChanged(QtProperty *property,
                 const QString &attribute, const QVariant &value)
@@ -1240,7 +1650,7 @@ QtVariantPropertyManager::~QtVariantPropertyManager()
 */
 QtVariantProperty *QtVariantPropertyManager::variantProperty(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
+    const QHash<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
     if (it == d_ptr->m_propertyToType.constEnd())
         return 0;
     return it.value().first;
@@ -1301,6 +1711,8 @@ QtVariantProperty *QtVariantPropertyManager::addProperty(int propertyType, const
 */
 QVariant QtVariantPropertyManager::value(const QtProperty *property) const
 {
+    d_ptr->pullValue(property);
+
     QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
     if (internProp == 0)
         return QVariant();
@@ -1387,7 +1799,7 @@ int QtVariantPropertyManager::valueType(int propertyType) const
 */
 int QtVariantPropertyManager::propertyType(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
+    const QHash<const QtProperty *, QPair<QtVariantProperty *, int> >::const_iterator it = d_ptr->m_propertyToType.constFind(property);
     if (it == d_ptr->m_propertyToType.constEnd())
         return 0;
     return it.value().second;
@@ -1535,6 +1947,166 @@ int QtVariantPropertyManager::attributeType(int propertyType, const QString &att
     return itAttr.value();
 }
 
+/*!
+    Returns the values the given \a property is bound to, or an empty
+    vector if the property is not bound to several values.
+
+    \sa setValues(), isMixed()
+*/
+QVector<QVariant> QtVariantPropertyManager::values(const QtProperty *property) const
+{
+    const auto it = d_ptr->m_propertyToValues.constFind(property);
+    if (it == d_ptr->m_propertyToValues.constEnd())
+        return QVector<QVariant>();
+    return it.value().values;
+}
+
+/*!
+    Returns true if the given \a property is bound to several values
+    that are not all equal. A mixed property shows a placeholder
+    instead of its value text until it is given a new value.
+
+    A subproperty that edits a component of a mixed value, such as the
+    width of a QSize, is mixed as well if that component differs across
+    the bound values.
+
+    \sa setValues(), values()
+*/
+bool QtVariantPropertyManager::isMixed(const QtProperty *property) const
+{
+    if (d_ptr->m_mixedSubProperties.contains(property))
+        return true;
+    const auto it = d_ptr->m_propertyToValues.constFind(property);
+    return it != d_ptr->m_propertyToValues.constEnd() && it.value().mixed;
+}
+
+/*!
+    \reimp
+
+    Bool and enum properties are edited in place.
+*/
+QtInlineEditing *QtVariantPropertyManager::inlineEditing() const
+{
+    return d_ptr.data();
+}
+
+/*!
+    Binds the given \a property to \a values, typically one value per
+    selected object, so that the property edits all of them at once.
+
+    If all \a values are equal the property shows that common value;
+    otherwise it is marked as mixed and holds the first value. The
+    next change of the property's value, whether made by an editor or
+    by setValue(), replaces all bound values and emits a single
+    valuesChanged() signal. Setting a mixed property to the value it
+    holds also replaces all bound values.
+
+    Of mixed values whose components are edited as subproperties, such
+    as QSize, QRect, QColor, QFont, QSizePolicy, QLocale and flags, only
+    the components that differ from the held value are written to each
+    bound value, so editing the width of several sizes keeps their
+    heights. The property stays mixed while the values still differ, and
+    so do the subproperties of the components that differ. Setting such
+    a subproperty to the component it holds writes that component to all
+    bound values.
+
+    Passing an empty vector unbinds the property.
+
+    \sa values(), isMixed(), valuesChanged()
+*/
+void QtVariantPropertyManager::setValues(QtProperty *property, const QVector<QVariant> &values)
+{
+    if (!d_ptr->m_propertyToType.contains(property))
+        return;
+
+    if (values.isEmpty()) {
+        if (d_ptr->m_propertyToValues.remove(property)) {
+            notifyPropertyChanged(property);
+            d_ptr->updateMixedSubProperties(property);
+        }
+        return;
+    }
+
+    QtVariantPropertyManagerPrivate::MultiValue &multiValue = d_ptr->m_propertyToValues[property];
+    multiValue.values = values;
+    multiValue.mixed = !qtIsUniform(values.constData(), values.constData() + values.count());
+
+    const bool wasBinding = d_ptr->m_bindingValues;
+    d_ptr->m_bindingValues = true;
+    setValue(property, values.first());
+    d_ptr->m_bindingValues = wasBinding;
+
+    // the mixed state can change without the value itself changing
+    notifyPropertyChanged(property);
+    d_ptr->updateMixedSubProperties(property);
+}
+
+/*!
+    Returns the value source the given \a property is bound to, or 0
+    if the property holds its own value.
+
+    \sa setValueSource()
+*/
+QtVariantValueSource *QtVariantPropertyManager::valueSource(const QtProperty *property) const
+{
+    return d_ptr->m_propertyToSource.value(property).source;
+}
+
+/*!
+    Binds the given \a property to \a source, or unbinds it if \a
+    source is 0. The manager does not take ownership of the source.
+
+    A bound property reads its value from the source on demand: only
+    when the value, value text or value icon is requested, which for
+    browsers means only for the properties they display, and only if
+    the source reports a version that differs from the one last read.
+    Changes made through the manager, by an editor or by setValue(),
+    are written to the source with QtVariantValueSource::setValue().
+
+    \sa valueSource(), updateValues()
+*/
+void QtVariantPropertyManager::setValueSource(QtProperty *property, QtVariantValueSource *source)
+{
+    if (!d_ptr->m_propertyToType.contains(property))
+        return;
+
+    if (!source) {
+        d_ptr->m_propertyToSource.remove(property);
+        return;
+    }
+
+    QtVariantPropertyManagerPrivate::SourceBinding binding;
+    binding.source = source;
+    d_ptr->m_propertyToSource[property] = binding;
+    notifyPropertyChanged(property);
+}
+
+/*!
+    Checks the versions reported by the value sources of all bound
+    properties, and notifies the browsers about the properties whose
+    version changed since their value was last read. No value is read
+    here; the browsers read the new values of the properties they
+    display when they update them.
+
+    Call this function after the data behind the sources has changed.
+
+    \sa setValueSource(), QtVariantValueSource::version()
+*/
+void QtVariantPropertyManager::updateValues()
+{
+    QList<QtProperty *> changed;
+    for (auto it = d_ptr->m_propertyToSource.begin(); it != d_ptr->m_propertyToSource.end(); ++it) {
+        QtVariantPropertyManagerPrivate::SourceBinding &binding = it.value();
+        if (binding.stale || binding.source->version(it.key()) == binding.version)
+            continue;
+        binding.stale = true;
+        changed.append(const_cast<QtProperty *>(it.key()));
+    }
+
+    for (QtProperty *property : qAsConst(changed))
+        notifyPropertyChanged(property);
+}
+
 /*!
     \fn void QtVariantPropertyManager::setValue(QtProperty *property, const QVariant &value)
 
@@ -1562,6 +2134,28 @@ void QtVariantPropertyManager::setValue(QtProperty *property, const QVariant &va
     if (internProp == 0)
         return;
 
+    // The typed managers ignore an unchanged value, which would leave a
+    // mixed property mixed when the value of the first object is chosen.
+    if (!d_ptr->m_bindingValues) {
+        const auto it = d_ptr->m_propertyToValues.find(property);
+        if (it != d_ptr->m_propertyToValues.end() && it.value().mixed) {
+            const QVariant current = value(property);
+            if (current == val) {
+                it.value().values.fill(current);
+                it.value().mixed = false;
+                emit valuesChanged(property, it.value().values);
+                notifyPropertyChanged(property);
+                d_ptr->updateMixedSubProperties(property);
+                return;
+            }
+        }
+        // likewise for a mixed subproperty, which resolves its component
+        const auto itSub = d_ptr->m_mixedSubProperties.constFind(property);
+        if (itSub != d_ptr->m_mixedSubProperties.constEnd() && value(property) == val) {
+            d_ptr->resolveMixedSubProperty(itSub.value(), property);
+            return;
+        }
+    }
 
     QtAbstractPropertyManager *manager = internProp->propertyManager();
     if (QtIntPropertyManager *intManager = qobject_cast<QtIntPropertyManager *>(manager)) {
@@ -1751,6 +2345,9 @@ bool QtVariantPropertyManager::hasValue(const QtProperty *property) const
 */
 QString QtVariantPropertyManager::valueText(const QtProperty *property) const
 {
+    if (isMixed(property))
+        return tr("<mixed>");
+    d_ptr->pullValue(property);
     const QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
     return internProp ? internProp->valueText() : QString();
 }
@@ -1760,6 +2357,9 @@ QString QtVariantPropertyManager::valueText(const QtProperty *property) const
 */
 QIcon QtVariantPropertyManager::valueIcon(const QtProperty *property) const
 {
+    if (isMixed(property))
+        return QIcon();
+    d_ptr->pullValue(property);
     const QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
     return internProp ? internProp->valueIcon() : QIcon();
 }
@@ -1799,22 +2399,42 @@ void QtVariantPropertyManager::initializeProperty(QtProperty *property)
 */
 void QtVariantPropertyManager::uninitializeProperty(QtProperty *property)
 {
-    const QMap<const QtProperty *, QPair<QtVariantProperty *, int> >::iterator type_it = d_ptr->m_propertyToType.find(property);
-    if (type_it == d_ptr->m_propertyToType.end())
+    if (!d_ptr->m_propertyToType.contains(property))
         return;
 
-    PropertyMap::iterator it = propertyToWrappedProperty()->find(property);
-    if (it != propertyToWrappedProperty()->end()) {
-        QtProperty *internProp = it.value();
-        if (internProp) {
-            d_ptr->m_internalToProperty.remove(internProp);
-            if (!d_ptr->m_destroyingSubProperties) {
-                delete internProp;
-            }
+    // Deleting the internal property can remove further entries, which may
+    // rehash the tables, so no iterators are held across it.
+    QtProperty *internProp = propertyToWrappedProperty()->take(property);
+    if (internProp) {
+        d_ptr->m_internalToProperty.remove(internProp);
+        if (!d_ptr->m_destroyingSubProperties) {
+            delete internProp;
         }
-        propertyToWrappedProperty()->erase(it);
     }
-    d_ptr->m_propertyToType.erase(type_it);
+    d_ptr->m_propertyToType.remove(property);
+    d_ptr->m_propertyToValues.remove(property);
+    d_ptr->m_mixedSubProperties.remove(property);
+    d_ptr->m_propertyToSource.remove(property);
+    d_ptr->m_pulledSubProperties.removeAll(property);
+}
+
+/*!
+    \internal
+*/
+bool QtVariantPropertyManager::hasDeferredSubProperties(const QtProperty *property) const
+{
+    const QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
+    return internProp ? internProp->hasDeferredSubProperties() : false;
+}
+
+/*!
+    \internal
+*/
+void QtVariantPropertyManager::createDeferredSubProperties(QtProperty *property)
+{
+    QtProperty *internProp = propertyToWrappedProperty()->value(property, 0);
+    if (internProp)
+        internProp->createDeferredSubProperties();
 }
 
 /*!
@@ -1853,8 +2473,8 @@ public:
     QtColorEditorFactory       *m_colorEditorFactory;
     QtFontEditorFactory        *m_fontEditorFactory;
 
-    QMap<QtAbstractEditorFactoryBase *, int> m_factoryToType;
-    QMap<int, QtAbstractEditorFactoryBase *> m_typeToFactory;
+    QHash<QtAbstractEditorFactoryBase *, int> m_factoryToType;
+    QHash<int, QtAbstractEditorFactoryBase *> m_typeToFactory;
 };
 
 /*!
@@ -2209,6 +2829,243 @@ void QtVariantEditorFactory::disconnectPropertyManager(QtVariantPropertyManager
         d_ptr->m_checkBoxFactory->removePropertyManager(manager->subBoolPropertyManager());
 }
 
+class QtVariantPropertySchemaPrivate
+{
+    QtVariantPropertySchema *q_ptr;
+    Q_DECLARE_PUBLIC(QtVariantPropertySchema)
+public:
+    QtVariantPropertySchemaPrivate() : m_manager(0), m_binding(false) {}
+
+    void slotValueChanged(QtProperty *property, const QVariant &value);
+    void slotPropertyDestroyed(QtProperty *property);
+
+    QtVariantPropertyManager *m_manager;
+    bool m_binding;
+
+    QStringList m_ids;
+    QList<QtProperty *> m_topLevelProperties;
+    QHash<QString, QtVariantProperty *> m_idToProperty;
+    QHash<const QtProperty *, QString> m_propertyToId;
+};
+
+void QtVariantPropertySchemaPrivate::slotValueChanged(QtProperty *property, const QVariant &value)
+{
+    if (m_binding)
+        return;
+
+    const auto it = m_propertyToId.constFind(property);
+    if (it == m_propertyToId.constEnd())
+        return;
+
+    emit q_ptr->valueChanged(it.value(), value);
+}
+
+void QtVariantPropertySchemaPrivate::slotPropertyDestroyed(QtProperty *property)
+{
+    const auto it = m_propertyToId.find(property);
+    if (it == m_propertyToId.end())
+        return;
+
+    m_idToProperty.remove(it.value());
+    m_ids.removeOne(it.value());
+    m_topLevelProperties.removeOne(property);
+    m_propertyToId.erase(it);
+}
+
+/*!
+    \class QtVariantPropertySchema
+    \inmodule QtDesigner
+
+    \brief The QtVariantPropertySchema class describes a reusable set of
+    variant properties that can be rebound to different data sources.
+
+    A schema owns a tree of properties created by a single
+    QtVariantPropertyManager. Each property is registered under an
+    application defined identifier. The tree is built once, typically
+    per object type, and is then bound to a particular object by
+    pushing that object's values with setValues(). Selecting another
+    object of the same type costs only the value updates: the
+    properties, the browser items and the editors are all kept.
+
+    Use the valueChanged() signal to write edits back to the bound
+    object. It is emitted only for changes made by the user, not for
+    the values pushed through setValue() or setValues().
+
+    \sa QtVariantPropertyManager
+*/
+
+/*!
+    \fn void QtVariantPropertySchema::valueChanged(const QString &id, const QVariant &value)
+
+    This signal is emitted whenever the property registered under \a id
+    is changed by anything but setValue() or setValues(), passing the
+    new \a value as parameter.
+*/
+
+/*!
+    Creates a schema whose properties are created by the given
+    \a manager, with the given \a parent.
+*/
+QtVariantPropertySchema::QtVariantPropertySchema(QtVariantPropertyManager *manager, QObject *parent)
+    : QObject(parent), d_ptr(new QtVariantPropertySchemaPrivate)
+{
+    d_ptr->q_ptr = this;
+    d_ptr->m_manager = manager;
+
+    connect(manager, SIGNAL(valueChanged(QtProperty *, const QVariant &)),
+                this, SLOT(slotValueChanged(QtProperty *, const QVariant &)));
+    connect(manager, SIGNAL(propertyDestroyed(QtProperty *)),
+                this, SLOT(slotPropertyDestroyed(QtProperty *)));
+}
+
+/*!
+    Destroys this schema, and all the properties it has created.
+*/
+QtVariantPropertySchema::~QtVariantPropertySchema()
+{
+    clear();
+}
+
+/*!
+    Returns the manager that creates the properties of this schema.
+*/
+QtVariantPropertyManager *QtVariantPropertySchema::propertyManager() const
+{
+    return d_ptr->m_manager;
+}
+
+/*!
+    Creates a property of the given \a propertyType with the given
+    \a name, and registers it under \a id. If \a parent is 0 the
+    property becomes a top level property of the schema; otherwise it
+    is added as a subproperty of \a parent.
+
+    Returns 0 if \a id is already in use or if the manager does not
+    support \a propertyType.
+
+    \sa property(), properties()
+*/
+QtVariantProperty *QtVariantPropertySchema::addProperty(const QString &id, int propertyType,
+            const QString &name, QtProperty *parent)
+{
+    Q_D(QtVariantPropertySchema);
+    if (d->m_idToProperty.contains(id))
+        return 0;
+
+    QtVariantProperty *property = d->m_manager->addProperty(propertyType, name);
+    if (!property)
+        return 0;
+
+    d->m_ids.append(id);
+    d->m_idToProperty[id] = property;
+    d->m_propertyToId[property] = id;
+    if (parent)
+        parent->addSubProperty(property);
+    else
+        d->m_topLevelProperties.append(property);
+    return property;
+}
+
+/*!
+    Returns the property registered under \a id, or 0 if there is no
+    such property.
+*/
+QtVariantProperty *QtVariantPropertySchema::property(const QString &id) const
+{
+    return d_ptr->m_idToProperty.value(id, 0);
+}
+
+/*!
+    Returns the identifier the given \a property is registered under,
+    or an empty string if \a property does not belong to this schema.
+*/
+QString QtVariantPropertySchema::id(const QtProperty *property) const
+{
+    return d_ptr->m_propertyToId.value(property);
+}
+
+/*!
+    Returns the identifiers of all properties in this schema, in the
+    order the properties were added.
+*/
+QStringList QtVariantPropertySchema::ids() const
+{
+    return d_ptr->m_ids;
+}
+
+/*!
+    Returns the top level properties of this schema, in the order
+    they were added. These are the properties to add to a browser.
+*/
+QList<QtProperty *> QtVariantPropertySchema::properties() const
+{
+    return d_ptr->m_topLevelProperties;
+}
+
+/*!
+    Returns the value of the property registered under \a id.
+*/
+QVariant QtVariantPropertySchema::value(const QString &id) const
+{
+    if (QtVariantProperty *property = d_ptr->m_idToProperty.value(id, 0))
+        return property->value();
+    return QVariant();
+}
+
+/*!
+    Sets the value of the property registered under \a id to \a value,
+    without emitting valueChanged().
+
+    \sa setValues()
+*/
+void QtVariantPropertySchema::setValue(const QString &id, const QVariant &value)
+{
+    Q_D(QtVariantPropertySchema);
+    QtVariantProperty *property = d->m_idToProperty.value(id, 0);
+    if (!property)
+        return;
+
+    const bool wasBinding = d->m_binding;
+    d->m_binding = true;
+    property->setValue(value);
+    d->m_binding = wasBinding;
+}
+
+/*!
+    Rebinds the schema to a new data source by pushing the given
+    \a values, keyed by property identifier. Identifiers that are not
+    part of the schema are ignored, and properties without an entry
+    in \a values keep their current value. Only the properties whose
+    value actually differs are updated in the browsers.
+
+    No valueChanged() signal is emitted.
+*/
+void QtVariantPropertySchema::setValues(const QMap<QString, QVariant> &values)
+{
+    Q_D(QtVariantPropertySchema);
+    const bool wasBinding = d->m_binding;
+    d->m_binding = true;
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+        if (QtVariantProperty *property = d->m_idToProperty.value(it.key(), 0))
+            property->setValue(it.value());
+    }
+    d->m_binding = wasBinding;
+}
+
+/*!
+    Deletes all the properties of this schema.
+*/
+void QtVariantPropertySchema::clear()
+{
+    Q_D(QtVariantPropertySchema);
+    const QList<QtVariantProperty *> properties = d->m_idToProperty.values();
+    d->m_ids.clear();
+    d->m_topLevelProperties.clear();
+    d->m_idToProperty.clear();
+    d->m_propertyToId.clear();
+    qDeleteAll(properties);
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qtvariantproperty.cpp"
@@ -42,6 +42,7 @@
 
 #include "qtpropertybrowser.h"
 #include <QtCore/QVariant>
+#include <QtCore/QVector>
 #include <QtGui/QIcon>
 
 QT_BEGIN_NAMESPACE
@@ -50,6 +51,16 @@ typedef QMap<int, QIcon> QtIconMap;
 
 class QtVariantPropertyManager;
 
+class QtVariantValueSource
+{
+public:
+    virtual ~QtVariantValueSource() {}
+
+    virtual QVariant value(const QtProperty *property) const = 0;
+    virtual void setValue(QtProperty *property, const QVariant &value) = 0;
+    virtual uint version(const QtProperty *property) const = 0;
+};
+
 class QtVariantProperty : public QtProperty
 {
 public:
@@ -89,16 +100,27 @@ public:
     virtual QVariant value(const QtProperty *property) const;
     virtual QVariant attributeValue(const QtProperty *property, const QString &attribute) const;
 
+    QVector<QVariant> values(const QtProperty *property) const;
+    bool isMixed(const QtProperty *property) const;
+
+    QtInlineEditing *inlineEditing() const;
+
+    QtVariantValueSource *valueSource(const QtProperty *property) const;
+    void setValueSource(QtProperty *property, QtVariantValueSource *source);
+
     static int enumTypeId();
     static int flagTypeId();
     static int groupTypeId();
     static int iconMapTypeId();
 public Q_SLOTS:
     virtual void setValue(QtProperty *property, const QVariant &val);
+    void setValues(QtProperty *property, const QVector<QVariant> &values);
+    void updateValues();
     virtual void setAttribute(QtProperty *property,
                 const QString &attribute, const QVariant &value);
 Q_SIGNALS:
     void valueChanged(QtProperty *property, const QVariant &val);
+    void valuesChanged(QtProperty *property, const QVector<QVariant> &values);
     void attributeChanged(QtProperty *property,
                 const QString &attribute, const QVariant &val);
 protected:
@@ -108,6 +130,8 @@ protected:
     virtual void initializeProperty(QtProperty *property);
     virtual void uninitializeProperty(QtProperty *property);
     virtual QtProperty *createProperty();
+    virtual bool hasDeferredSubProperties(const QtProperty *property) const;
+    virtual void createDeferredSubProperties(QtProperty *property);
 private:
     QScopedPointer<class QtVariantPropertyManagerPrivate> d_ptr;
     Q_PRIVATE_SLOT(d_func(), void slotValueChanged(QtProperty *, int))
@@ -147,6 +171,7 @@ private:
 
     Q_PRIVATE_SLOT(d_func(), void slotPropertyInserted(QtProperty *, QtProperty *, QtProperty *))
     Q_PRIVATE_SLOT(d_func(), void slotPropertyRemoved(QtProperty *, QtProperty *))
+    Q_PRIVATE_SLOT(d_func(), void slotNotifyPulledSubProperties())
     Q_DECLARE_PRIVATE(QtVariantPropertyManager)
     Q_DISABLE_COPY_MOVE(QtVariantPropertyManager)
 };
@@ -168,6 +193,39 @@ private:
     Q_DISABLE_COPY_MOVE(QtVariantEditorFactory)
 };
 
+class QtVariantPropertySchema : public QObject
+{
+    Q_OBJECT
+public:
+    QtVariantPropertySchema(QtVariantPropertyManager *manager, QObject *parent = 0);
+    ~QtVariantPropertySchema();
+
+    QtVariantPropertyManager *propertyManager() const;
+
+    QtVariantProperty *addProperty(const QString &id, int propertyType,
+                const QString &name = QString(), QtProperty *parent = 0);
+
+    QtVariantProperty *property(const QString &id) const;
+    QString id(const QtProperty *property) const;
+    QStringList ids() const;
+    QList<QtProperty *> properties() const;
+
+    QVariant value(const QString &id) const;
+    void setValue(const QString &id, const QVariant &value);
+    void setValues(const QMap<QString, QVariant> &values);
+
+    void clear();
+
+Q_SIGNALS:
+    void valueChanged(const QString &id, const QVariant &value);
+private:
+    QScopedPointer<class QtVariantPropertySchemaPrivate> d_ptr;
+    Q_DECLARE_PRIVATE(QtVariantPropertySchema)
+    Q_DISABLE_COPY_MOVE(QtVariantPropertySchema)
+    Q_PRIVATE_SLOT(d_func(), void slotValueChanged(QtProperty *, const QVariant &))
+    Q_PRIVATE_SLOT(d_func(), void slotPropertyDestroyed(QtProperty *))
+};
+
 QT_END_NAMESPACE
 
 Q_DECLARE_METATYPE(QIcon)